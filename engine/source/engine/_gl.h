@@ -4,6 +4,7 @@
 #include "_global.h"
 #include "glew.h"
 #include "glfw3.h"
+#include "perfstats.h"
 
 //#define MAT4_ROW_MAJOR
 
@@ -350,3 +351,148 @@
 #undef glViewport
 #define glViewport(...) GLMock::invoking("glViewport")
 #endif
+
+
+// GL STATE CACHE
+ENGINE_NAMESPACE_BEGIN
+
+// Shadows the bindings and blend state of the render thread's context
+// and skips every call that wouldn't change them, counted in PerfStats.
+//
+// Only works if binds and deletes of these objects go through here,
+// reset() after a new context or code that touched them directly.
+// Element array bindings are VAO state and always pass through.
+class GLStateCache
+{
+public:
+    static GLStateCache& instance() {
+        static GLStateCache INSTANCE;
+        return INSTANCE;
+    }
+
+    inline void use_program( GLuint id ) {
+        if ( _program == id ) { skipped(); return; }
+        glUseProgram( id );
+        _program = id;
+    }
+
+    inline void bind_vertex_array( GLuint id ) {
+        if ( _vertexArray == id ) { skipped(); return; }
+        glBindVertexArray( id );
+        _vertexArray = id;
+    }
+
+    inline void bind_buffer( GLenum target, GLuint id ) {
+        GLuint* bound = buffer_slot( target );
+        if ( bound != nullptr && *bound == id ) { skipped(); return; }
+
+        glBindBuffer( target, id );
+        if ( bound != nullptr ) *bound = id;
+    }
+
+    // GL_TEXTURE_2D on unit, e.g. GL_TEXTURE0
+    inline void bind_texture( GLenum unit, GLuint id ) {
+        uint32 index = unit - GL_TEXTURE0;
+        if ( index >= NUM_TEXTURE_UNITS ) {
+            glActiveTexture( unit );
+            glBindTexture( GL_TEXTURE_2D, id );
+            _activeTexture = unit;
+            return;
+        }
+
+        if ( _textures[index] == id ) { skipped(); return; }
+
+        if ( _activeTexture != unit ) {
+            glActiveTexture( unit );
+            _activeTexture = unit;
+        }
+
+        glBindTexture( GL_TEXTURE_2D, id );
+        _textures[index] = id;
+    }
+
+    // GL_BLEND and GL_DEPTH_TEST are shadowed, anything else passes through
+    inline void set_enabled( GLenum cap, bool enabled ) {
+        bool* current = cap == GL_BLEND ? &_blend : cap == GL_DEPTH_TEST ? &_depthTest : nullptr;
+        if ( current != nullptr && *current == enabled ) { skipped(); return; }
+
+        if ( enabled ) glEnable( cap );
+        else           glDisable( cap );
+
+        if ( current != nullptr ) *current = enabled;
+    }
+
+    inline void blend_func( GLenum src, GLenum dst ) {
+        if ( _blendSrc == src && _blendDst == dst ) { skipped(); return; }
+        glBlendFunc( src, dst );
+        _blendSrc = src;
+        _blendDst = dst;
+    }
+
+    // Deleted names get reused by GL, so they must not look bound anymore
+    inline void forget_program( GLuint id ) {
+        if ( _program == id ) _program = 0;
+    }
+
+    inline void forget_vertex_array( GLuint id ) {
+        if ( _vertexArray == id ) _vertexArray = 0;
+    }
+
+    inline void forget_buffer( GLuint id ) {
+        for ( GLuint* bound : { &_arrayBuffer, &_copyReadBuffer, &_copyWriteBuffer, &_uniformBuffer } )
+            if ( *bound == id ) *bound = 0;
+    }
+
+    inline void forget_texture( GLuint id ) {
+        for ( GLuint& bound : _textures )
+            if ( bound == id ) bound = 0;
+    }
+
+    // Back to the defaults of a fresh context
+    inline void reset() {
+        _program = 0;
+        _vertexArray = 0;
+        _arrayBuffer = _copyReadBuffer = _copyWriteBuffer = _uniformBuffer = 0;
+        _activeTexture = GL_TEXTURE0;
+        for ( GLuint& bound : _textures ) bound = 0;
+        _blend = _depthTest = false;
+        _blendSrc = GL_ONE;
+        _blendDst = GL_ZERO;
+    }
+
+private:
+    GLStateCache() { reset(); }
+
+    inline GLuint* buffer_slot( GLenum target ) {
+        switch ( target ) {
+            case GL_ARRAY_BUFFER:       return &_arrayBuffer;
+            case GL_COPY_READ_BUFFER:   return &_copyReadBuffer;
+            case GL_COPY_WRITE_BUFFER:  return &_copyWriteBuffer;
+            case GL_UNIFORM_BUFFER:     return &_uniformBuffer;
+            default:                    return nullptr;
+        }
+    }
+
+    inline void skipped() {
+        PerfStats::instance().frame_redundant_gl_call();
+    }
+
+    static const uint32 NUM_TEXTURE_UNITS = 16;
+
+    GLuint  _program;
+    GLuint  _vertexArray;
+    GLuint  _arrayBuffer;
+    GLuint  _copyReadBuffer;
+    GLuint  _copyWriteBuffer;
+    GLuint  _uniformBuffer;
+
+    GLenum  _activeTexture;
+    GLuint  _textures[NUM_TEXTURE_UNITS];
+
+    bool    _blend;
+    bool    _depthTest;
+    GLenum  _blendSrc;
+    GLenum  _blendDst;
+};
+
+ENGINE_NAMESPACE_END
@@ -0,0 +1,97 @@
+#include "stdafx.h"
+#include "affine2d.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                      Public Static                     */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+const Affine2D Affine2D::IDENTITY = Affine2D();
+
+Affine2D Affine2D::translation( const Vector2f& v )
+{
+    return Affine2D( 1, 0, v.x,
+                     0, 1, v.y );
+}
+
+Affine2D Affine2D::scaling( const Vector2f& v )
+{
+    return trs<false>( 0, 0, 1, 0, v.x, v.y );
+}
+
+Affine2D Affine2D::rotation( float angle )
+{
+    Vector2f r = direction( angle );
+    return trs<true>( 0, 0, r.x, r.y, 1, 1 );
+}
+
+Vector2f Affine2D::direction( float angle )
+{
+    return Vector2f( std::cos( angle ), std::sin( angle ) );
+}
+
+float Affine2D::angle( const Vector2f& direction )
+{
+    return std::atan2( direction.y, direction.x );
+}
+
+Vector2f Affine2D::nlerp( const Vector2f& from, const Vector2f& to, float t )
+{
+    // Opposite directions have no shorter arc and no direction in between
+    Vector2f r = from + (to - from) * t;
+    float length = r.length();
+
+    Guard( length > 0.0f ) return from;
+    return r / length;
+}
+
+Affine2D Affine2D::lerp( const Affine2D& from, const Affine2D& to, float t )
+{
+    return Affine2D( from.m00 + (to.m00 - from.m00) * t, from.m01 + (to.m01 - from.m01) * t, from.m02 + (to.m02 - from.m02) * t,
+                     from.m10 + (to.m10 - from.m10) * t, from.m11 + (to.m11 - from.m11) * t, from.m12 + (to.m12 - from.m12) * t );
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Public                         */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+bool Affine2D::operator==( const Affine2D& o ) const
+{
+    return m00 == o.m00 && m01 == o.m01 && m02 == o.m02
+        && m10 == o.m10 && m11 == o.m11 && m12 == o.m12;
+}
+
+bool Affine2D::operator!=( const Affine2D& o ) const
+{
+    return !(*this == o);
+}
+
+Affine2D Affine2D::operator*( const Affine2D& o ) const
+{
+    return Affine2D( m00 * o.m00 + m01 * o.m10, m00 * o.m01 + m01 * o.m11, m00 * o.m02 + m01 * o.m12 + m02,
+                     m10 * o.m00 + m11 * o.m10, m10 * o.m01 + m11 * o.m11, m10 * o.m02 + m11 * o.m12 + m12 );
+}
+
+Vector2f Affine2D::transform( const Vector2f& point ) const
+{
+    return Vector2f( m00 * point.x + m01 * point.y + m02,
+                     m10 * point.x + m11 * point.y + m12 );
+}
+
+Rect4f Affine2D::transform( const Rect4f& rect ) const
+{
+    // Center moves like a point, the half extents grow by the absolute linear part
+    Vector2f center = transform( Vector2f( rect.min_x() + rect.width() / 2, rect.min_y() + rect.height() / 2 ) );
+    float halfW = (std::abs( m00 ) * rect.width() + std::abs( m01 ) * rect.height()) / 2;
+    float halfH = (std::abs( m10 ) * rect.width() + std::abs( m11 ) * rect.height()) / 2;
+
+    return Rect4f( center.x - halfW, center.y - halfH, 2 * halfW, 2 * halfH );
+}
+
+const float* Affine2D::data() const
+{
+    return &m00;
+}
+
+ENGINE_NAMESPACE_END
@@ -0,0 +1,88 @@
+#pragma once
+
+// Std-Includes
+#include <cmath>
+
+// Other Includes
+
+// Internal Includes
+#include "_mathdefs.h"
+#include "vector2f.h"
+#include "rect4f.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+/**
+* 2x3 transform for the 2D renderers: rotation around z, scale and translation
+* in 6 floats instead of the 16 of a Matrix4f. Points are dotted with the
+* rows and m02, m12 are the translation, like in Matrix4f.
+*
+* Products compose in the opposite order to Matrix4f: a * b applies b first,
+* as in math notation, while a Matrix4f a * b applies a first. Code moved
+* between the two has to swap its operands.
+*
+* Rotations are kept as the unit vector ( cos, sin ) of their angle, so
+* interpolating and composing them needs no trigonometry.
+*/
+class Affine2D
+{
+public:
+    static const Affine2D IDENTITY;
+
+    static Affine2D translation( const Vector2f& v );
+    static Affine2D scaling( const Vector2f& v );
+    static Affine2D rotation( float angle );
+
+    // Translation * rotation * scale, rotation given as ( cos, sin ). Without
+    // ROTATED the rotation is left out at compile time, for everything that
+    // doesn't turn.
+    template<bool ROTATED = true>
+    static constexpr Affine2D trs( float x, float y, float cos, float sin, float sx, float sy );
+
+    // Rotation around z as ( cos, sin ) and back
+    static Vector2f direction( float angle );
+    static float    angle( const Vector2f& direction );
+
+    // Rotations ( cos, sin ) along the shorter arc, renormalized instead of slerped
+    static Vector2f nlerp( const Vector2f& from, const Vector2f& to, float t );
+
+    // Per field, exact for transforms that only translate and scale
+    static Affine2D lerp( const Affine2D& from, const Affine2D& to, float t );
+
+    constexpr Affine2D() : Affine2D( 1, 0, 0, 0, 1, 0 ) { }
+    constexpr Affine2D( float v00, float v01, float v02,
+                        float v10, float v11, float v12 )
+        : m00( v00 ), m01( v01 ), m02( v02 ),
+          m10( v10 ), m11( v11 ), m12( v12 ) { }
+              ~Affine2D() = default;
+
+    bool     operator==( const Affine2D& o ) const;
+    bool     operator!=( const Affine2D& o ) const;
+
+    // o first, then this. The reverse of Matrix4f::operator*.
+    Affine2D operator*( const Affine2D& o ) const;
+
+    Vector2f transform( const Vector2f& point ) const;
+
+    // Axis-aligned bounds of the transformed rect
+    Rect4f   transform( const Rect4f& rect ) const;
+
+    // The 6 fields in declaration order, uploads as mat2x3 with transpose = false
+    const float* data() const;
+
+    float m00, m01, m02;
+    float m10, m11, m12;
+};
+
+template<bool ROTATED>
+constexpr Affine2D Affine2D::trs( float x, float y, float cos, float sin, float sx, float sy )
+{
+    if constexpr ( ROTATED )
+        return Affine2D( cos * sx, -sin * sy, x,
+                         sin * sx,  cos * sy, y );
+    else
+        return Affine2D( sx, 0, x,
+                         0, sy, y );
+}
+
+ENGINE_NAMESPACE_END
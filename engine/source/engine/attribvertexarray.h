@@ -6,30 +6,51 @@
 
 // Internal Includes
 #include "_global.h"
+#include "perfstats.h"
 #include "glvao.h"
 #include "vertex.h"
+#include "primitivetype.h"
 #include "simpleindexbuffer.h"
 #include "attribvertexbuffer.h"
 #include "gltype.h"
 
 ENGINE_NAMESPACE_BEGIN
 
+// Vertex array with one AttribVertexBuffer per attribute of VERTEX (SoA).
+//
+// Attributes with a divisor ( see VertexComponent ) are per instance:
+//
+//    vao.get_vertex_buffer( 0 )->add( corners );             // per vertex, once
+//    vao.stream( 1, ring, data, numSprites );                 // per instance, per frame
+//    vao.render_instanced( PrimitiveType::TRIANGLE_STRIP, 4, 0, numSprites );
 template<typename VERTEX>
-class AttribVertexArray : GLVAO<VERTEX>
+class AttribVertexArray : public GLVAO<VERTEX>
 {
     static_assert(std::is_base_of<Vertex, VERTEX>::value, "Template parameter is not a Vertex type!");
 
 public:
     AttribVertexArray();
-    ~AttribVertexArray() = default;
+    ~AttribVertexArray();
 
+    // Splits the interleaved vertex data into the attribute buffers
     std::vector<uint32>          add_vertices( std::vector<VERTEX> pVertices );
+    weak<AttribVertexBuffer>     get_vertex_buffer( uint32 attribLocation );
     optional<SimpleIndexBuffer>& get_index_buffer();
 
+    // Replaces the content of one attribute with data written into the ring
+    void                         stream( uint32 attribLocation, StreamBuffer& ring, const float* data, size_t numObjs );
+
+    // Lets one attribute read from a range of another buffer, see AttribVertexBuffer::source()
+    void                         source( uint32 attribLocation, GLuint buffer, size_t offset, size_t numObjs );
 
     void                render_by_indexbuffer();
     void                render_all();
 
+    // Draws numVertices per-vertex attributes numInstances times, with the
+    // per-instance attributes starting at firstInstance. GL 3.3 has no base
+    // instance, so a different firstInstance re-points those attributes.
+    void                render_instanced( PrimitiveType type, size_t numVertices, size_t firstInstance, size_t numInstances );
+
 protected:
     using GLVAO<VERTEX>::native_create;
     using GLVAO<VERTEX>::native_bind;
@@ -39,17 +60,26 @@ protected:
     using GLVAO<VERTEX>::layout;
 
 private:
-    void                native_layout();
+    void                native_layout( size_t firstInstance );
+    size_t              num_vertices();
 
     void                create_vertexbuffers();
     void                create_indexbuffer();
 
     optional<SimpleIndexBuffer>             _indexBuffer;
+
+    // Indexed by attribute location
     std::vector<owner<AttribVertexBuffer>>  _vertexBuffers;
+
+    // Instance the per-instance attributes currently point at
+    size_t                                  _firstInstance;
+
+    // An attribute moved to another buffer or offset since the last layout
+    bool                                    _layoutDirty;
 };
 
 template<typename VERTEX>
-AttribVertexArray<VERTEX>::AttribVertexArray() : GLVAO<VERTEX>()
+AttribVertexArray<VERTEX>::AttribVertexArray() : GLVAO<VERTEX>(), _firstInstance( 0 ), _layoutDirty( false )
 {
     native_create();
 
@@ -57,15 +87,44 @@ AttribVertexArray<VERTEX>::AttribVertexArray() : GLVAO<VERTEX>()
     create_indexbuffer();
 }
 
+template<typename VERTEX>
+AttribVertexArray<VERTEX>::~AttribVertexArray()
+{
+    native_delete();
+}
+
 template<typename VERTEX>
 std::vector<uint32> AttribVertexArray<VERTEX>::add_vertices( std::vector<VERTEX> pVertices )
 {
-    VertexLayout& layout = layout();
-    layout.num_components();
+    Guard( pVertices.size() > 0 ) return std::vector<uint32>();
+
+    // 1# Deinterleave
+    std::vector<std::vector<float>> attributes( _vertexBuffers.size() );
 
     for ( auto& vertex : pVertices ) {
-        
+        size_t offset = 0;
+
+        for ( const VertexComponent& comp : layout().components() ) {
+            auto first = vertex.data.begin() + offset;
+            attributes[comp.position].insert( attributes[comp.position].end(), first, first + comp.num_components() );
+            offset += comp.num_components();
+        }
+    }
+
+    // 2# Append per attribute, all buffers grow in lockstep
+    std::vector<uint32> indices;
+    for ( const VertexComponent& comp : layout().components() ) {
+        indices = _vertexBuffers[comp.position]->add( attributes[comp.position] );
     }
+
+    return indices;
+}
+
+template<typename VERTEX>
+weak<AttribVertexBuffer> AttribVertexArray<VERTEX>::get_vertex_buffer( uint32 attribLocation )
+{
+    Requires( attribLocation < _vertexBuffers.size() );
+    return _vertexBuffers[attribLocation].get_non_owner();
 }
 
 template<typename VERTEX>
@@ -74,50 +133,100 @@ optional<SimpleIndexBuffer>& AttribVertexArray<VERTEX>::get_index_buffer()
     return _indexBuffer;
 }
 
+template<typename VERTEX>
+void AttribVertexArray<VERTEX>::stream( uint32 attribLocation, StreamBuffer& ring, const float* data, size_t numObjs )
+{
+    Requires( attribLocation < _vertexBuffers.size() );
+
+    _vertexBuffers[attribLocation]->stream( ring, data, numObjs );
+    _layoutDirty = true;
+}
+
+template<typename VERTEX>
+void AttribVertexArray<VERTEX>::source( uint32 attribLocation, GLuint buffer, size_t offset, size_t numObjs )
+{
+    Requires( attribLocation < _vertexBuffers.size() );
+
+    if ( _vertexBuffers[attribLocation]->source( buffer, offset, numObjs ) )
+        _layoutDirty = true;
+}
+
 template<class VERTEX>
 void AttribVertexArray<VERTEX>::render_by_indexbuffer() {
+    native_layout( 0 );
+
+    // Stays bound, the next draw of this array skips the bind
     native_bind();
-    glDrawElements( (GLuint)PrimitiveType::TRIANGLES, (GLsizei)_indexBuffer->num_objects(), GL_UNSIGNED_INT, BUFFER_OFFSET( 0 ) );
-    native_unbind();
+    glDrawElements( (GLuint)PrimitiveType::TRIANGLES, (GLsizei)_indexBuffer->size(), GL_UNSIGNED_INT, BUFFER_OFFSET( 0 ) );
 
-    PerfStats::instance().frame_draw_call( _indexBuffer->num_objects() / 3 );
+    PerfStats::instance().frame_draw_call( _indexBuffer->size() / 3 );
 }
 
 template<class VERTEX>
 void AttribVertexArray<VERTEX>::render_all() {
+    native_layout( 0 );
+
     native_bind();
-    glDrawArrays( (GLuint)PrimitiveType::TRIANGLES, 0, (GLsizei)_vertexBuffers[0]->size() );
-    native_unbind();
+    glDrawArrays( (GLuint)PrimitiveType::TRIANGLES, 0, (GLsizei)num_vertices() );
+
+    PerfStats::instance().frame_draw_call( num_vertices() / 3 );
+}
 
-    PerfStats::instance().frame_draw_call( _vertexBuffers[0]->size() / 3 );
+template<class VERTEX>
+void AttribVertexArray<VERTEX>::render_instanced( PrimitiveType type, size_t numVertices, size_t firstInstance, size_t numInstances ) {
+    Guard( numInstances > 0 ) return;
+
+    native_layout( firstInstance );
+
+    native_bind();
+    glDrawArraysInstanced( (GLenum)type, 0, (GLsizei)numVertices, (GLsizei)numInstances );
+
+    size_t polygons = type == PrimitiveType::TRIANGLE_STRIP ? numVertices - 2 : numVertices / 3;
+    PerfStats::instance().frame_draw_call( polygons * numInstances );
 }
 
 template<typename VERTEX>
-void AttribVertexArray<VERTEX>::native_layout()
+void AttribVertexArray<VERTEX>::native_layout( size_t firstInstance )
 {
-    VertexLayout& layout = layout();
+    Guard( _layoutDirty || firstInstance != _firstInstance ) return;
 
-    for ( auto comp : layout.components() ) {
-        owner<AttribVertexBuffer> tvbo = _vertexBuffers[ comp.position ];
+    native_bind();
 
+    for ( auto& vbo : _vertexBuffers ) {
         if ( vbo == nullptr ) continue;
+        if ( vbo->divisor() == 0 && !_layoutDirty ) continue;
 
-        native_bind();
-        vbo->native_bind();
-        vbo->native_vbo_layout();
-
-        native_unbind();
-        vbo->native_unbind();
+        vbo->native_attrib_location( vbo->divisor() == 0 ? 0 : firstInstance / vbo->divisor() );
     }
+
+    _firstInstance = firstInstance;
+    _layoutDirty   = false;
+}
+
+template<typename VERTEX>
+size_t AttribVertexArray<VERTEX>::num_vertices()
+{
+    for ( auto& vbo : _vertexBuffers )
+        if ( vbo != nullptr && vbo->divisor() == 0 )
+            return vbo->size();
+
+    return 0;
 }
 
 template<typename VERTEX>
 void AttribVertexArray<VERTEX>::create_vertexbuffers()
 {
-    _vertexBuffers.reserve( layout().num_components() );
+    uint32 numLocations = 0;
+    for ( const VertexComponent& comp : layout().components() ) {
+        numLocations = std::max( numLocations, comp.position + 1 );
+    }
 
-    for ( VertexComponent comp : layout().components() ) {
-        GLType& type = GLType::FLOAT;
+    _vertexBuffers.resize( numLocations );
+
+    native_bind();
+
+    for ( const VertexComponent& comp : layout().components() ) {
+        GLType type = GLType::FLOAT;
 
         if ( comp.type == string( "vec2" ) ) {
             type = GLType::VEC2;
@@ -128,14 +237,13 @@ void AttribVertexArray<VERTEX>::create_vertexbuffers()
         else if ( comp.type == string( "vec4" ) ) {
             type = GLType::VEC4;
         }
-        else if ( comp.type == string( "mat4" ) ) {
-            type = GLType::MAT4;
-        }
 
-        auto vbo = make_owner<AttribVertexBuffer>( type, comp.position );
-        auto pos = _vertexBuffers.begin() + comp.position;
-        _vertexBuffers.emplace( pos, std::move( vbo ) );
+        auto vbo = make_owner<AttribVertexBuffer>( type, comp.position, comp.divisor );
+        vbo->native_attrib_location( 0 );
+        _vertexBuffers[comp.position] = std::move( vbo );
     }
+
+    native_unbind();
 }
 
 template<typename VERTEX>
@@ -150,4 +258,4 @@ void AttribVertexArray<VERTEX>::create_indexbuffer()
     _indexBuffer->native_unbind();
 }
 
-ENGINE_NAMESPACE_END
\ No newline at end of file
+ENGINE_NAMESPACE_END
@@ -3,14 +3,16 @@
 
 ENGINE_NAMESPACE_BEGIN
 
-AttribVertexBuffer::AttribVertexBuffer( GLType pType, uint32 pAttribLocation ) :
+AttribVertexBuffer::AttribVertexBuffer( GLType pType, uint32 pAttribLocation, uint32 pDivisor ) :
     _size( 0 ), _atomCapacity( 0 ), _atomEnd( 0 ),
-    _attribLocation( pAttribLocation ), _type( pType )
+    _attribLocation( pAttribLocation ), _divisor( pDivisor ), _type( pType )
 {
-    native_create( (GLuint)(_atomCapacity * _type.numComps) );
-    native_bind();
-    native_attrib_location( _attribLocation );
-    native_unbind();
+    Requires( _type.numComps <= 4 );
+
+    native_create( (GLuint)(_atomCapacity * FLOAT_BYTES) );
+
+    _sourceId     = gl_id();
+    _sourceOffset = 0;
 }
 
 AttribVertexBuffer::~AttribVertexBuffer()
@@ -18,14 +20,73 @@ AttribVertexBuffer::~AttribVertexBuffer()
     native_delete();
 }
 
+void AttribVertexBuffer::assign( const float* data, size_t numObjs )
+{
+    size_t numAtoms = numObjs * _type.numComps;
+
+    native_bind();
+    glBufferData( GL_ARRAY_BUFFER, numAtoms * FLOAT_BYTES, nullptr, GL_STREAM_DRAW );
+    glBufferSubData( GL_ARRAY_BUFFER, 0, numAtoms * FLOAT_BYTES, data );
+
+    _atomCapacity = numAtoms;
+    _atomEnd      = numAtoms;
+    _size         = numObjs;
+    _sourceId     = gl_id();
+    _sourceOffset = 0;
+}
+
+void AttribVertexBuffer::stream( StreamBuffer& ring, const float* data, size_t numObjs )
+{
+    source( ring.gl_id(), ring.write( data, numObjs * _type.byteSize, _type.byteSize ), numObjs );
+}
+
+bool AttribVertexBuffer::source( GLuint buffer, size_t offset, size_t numObjs )
+{
+    bool moved = buffer != _sourceId || offset != _sourceOffset;
+
+    _sourceId     = buffer;
+    _sourceOffset = offset;
+
+    _atomEnd = 0;
+    _size    = numObjs;
+
+    return moved;
+}
+
+void AttribVertexBuffer::clear()
+{
+    _atomEnd = 0;
+    _size    = 0;
+}
+
 size_t AttribVertexBuffer::size()
 {
     return _size;
 }
 
-void AttribVertexBuffer::native_attrib_location( uint32 attribLoc )
+GLType AttribVertexBuffer::type() const
+{
+    return _type;
+}
+
+uint32 AttribVertexBuffer::attrib_location() const
 {
-    glVertexAttribPointer( (GLuint)attribLoc, (GLuint)_type.numComps, GL_FLOAT, GL_FALSE, (GLuint)_type.byteSize, BUFFER_OFFSET( 0 ) );
+    return _attribLocation;
 }
 
-ENGINE_NAMESPACE_END
\ No newline at end of file
+uint32 AttribVertexBuffer::divisor() const
+{
+    return _divisor;
+}
+
+void AttribVertexBuffer::native_attrib_location( size_t firstObj )
+{
+    // Tightly packed, one attribute per buffer
+    GLStateCache::instance().bind_buffer( GL_ARRAY_BUFFER, _sourceId );
+    glVertexAttribPointer( (GLuint)_attribLocation, (GLuint)_type.numComps, GL_FLOAT, GL_FALSE, (GLuint)_type.byteSize, BUFFER_OFFSET( _sourceOffset + firstObj * _type.byteSize ) );
+    glVertexAttribDivisor( (GLuint)_attribLocation, (GLuint)_divisor );
+}
+
+Logger AttribVertexBuffer::LOGGER = Logger( "AttribVertexBuffer", Level::WARN );
+
+ENGINE_NAMESPACE_END
@@ -16,32 +16,73 @@
 #include "matrix4f.h"
 
 #include "glbuffer.h"
+#include "streambuffer.h"
+#include "logger.h"
 
 
 
 ENGINE_NAMESPACE_BEGIN
 
-class AttribVertexBuffer : GLBuffer<float, GL_ARRAY_BUFFER>
+// Holds a single vertex attribute, see AttribVertexArray.
+//
+// With a divisor > 0 the attribute advances per instance instead of per
+// vertex. Objects are counted in whole attribute values, e.g. one vec4,
+// even when they are passed in as plain floats.
+class AttribVertexBuffer : public GLBuffer<float, GL_ARRAY_BUFFER>
 {
 public:
-    AttribVertexBuffer(GLType type, uint32 attribLocation);
+    AttribVertexBuffer( GLType type, uint32 attribLocation, uint32 divisor = 0 );
     ~AttribVertexBuffer();
 
     template<typename VAL>
     std::vector<uint32>    add( std::vector<VAL> objs );
+
+    // Overwrites already added objects in place, starting at object index first
+    template<typename VAL>
+    void                   set( size_t first, std::vector<VAL> objs );
+
+    // Replaces the whole content, numObjs * type().numComps floats. Orphans
+    // the old storage, so a draw still reading it doesn't stall the upload.
+    void                   assign( const float* data, size_t numObjs );
+
+    // Like assign(), but writes into the shared ring instead of this buffer.
+    // The attribute reads from the ring until the next add(), set() or assign().
+    void                   stream( StreamBuffer& ring, const float* data, size_t numObjs );
+
+    // Reads numObjs objects from another buffer starting at byte offset, e.g. a GpuHeap slice.
+    // Returns false if the attribute already read from there.
+    bool                   source( GLuint buffer, size_t offset, size_t numObjs );
+
+    void                   clear();
     size_t                 size();
 
-    void                   native_attrib_location( uint32 attribLocation );
+    GLType                 type() const;
+    uint32                 attrib_location() const;
+    uint32                 divisor() const;
+
+    // Points the attribute at its data, skipping the first firstObj objects
+    void                   native_attrib_location( size_t firstObj = 0 );
+
+    using GLBuffer<float, GL_ARRAY_BUFFER>::gl_id;
 
     using GLBuffer<float, GL_ARRAY_BUFFER>::native_bind;
+    using GLBuffer<float, GL_ARRAY_BUFFER>::native_unbind;
     using GLBuffer<float, GL_ARRAY_BUFFER>::native_copy;
     using GLBuffer<float, GL_ARRAY_BUFFER>::native_create;
     using GLBuffer<float, GL_ARRAY_BUFFER>::native_resize;
     using GLBuffer<float, GL_ARRAY_BUFFER>::native_write_at;
 
 private:
+    template<typename VAL>
+    std::vector<float>     to_atoms( const std::vector<VAL>& objs );
+
     GLType _type;
     uint32 _attribLocation;
+    uint32 _divisor;
+
+    // Where the attribute reads from, this buffer or a range of a StreamBuffer
+    GLuint _sourceId;
+    size_t _sourceOffset;
 
     size_t _size;
     size_t _atomCapacity;
@@ -55,44 +96,68 @@ template<typename VAL>
 std::vector<uint32> AttribVertexBuffer::add( std::vector<VAL> objs )
 {
     Guard( objs.size() > 0 ) return std::vector<uint32>();
+    Requires( _sourceId == gl_id() );
 
-    std::vector<float> data;
-
-    // For float values just copy the data 1:1
-    if constexpr(std::is_same_v<VAL, float>) {
-        data.insert( data.end(), objs.begin(), objs.end() );
-    }
-    else {
-        for ( auto obj : objs ) write_into( data, obj );
-    }
+    std::vector<float> data = to_atoms( objs );
 
     // 1# Resize if necessary
     size_t neededAtomCapacity = _atomEnd + data.size();
     if ( neededAtomCapacity > _atomCapacity ) {
-        size_t newAtomCapacity = _atomCapacity + RESIZE_BUFFER_SIZE;
+        // Geometric, so n objects added one by one cost O(log n) resizes
+        size_t newAtomCapacity = std::max( _atomCapacity * 2, (size_t)RESIZE_BUFFER_SIZE );
 
         while ( newAtomCapacity < neededAtomCapacity ) {
-            newAtomCapacity += RESIZE_BUFFER_SIZE;
+            newAtomCapacity *= 2;
         }
 
-        native_resize( (GLuint)_atomCapacity, (GLuint)newAtomCapacity );
+        native_resize( (GLuint)(_atomCapacity * FLOAT_BYTES), (GLuint)(newAtomCapacity * FLOAT_BYTES) );
+        _atomCapacity = newAtomCapacity;
     }
 
     // 2# Write to native
-    size_t writeStart = _atomEnd;
-    native_write_at( (GLuint)_atomEnd, data );
+    size_t writeStart = _size;
+    native_write_at( (GLuint)(_atomEnd * FLOAT_BYTES), data );
     _atomEnd += data.size();
-    _size += objs.size();
+    _size += data.size() / _type.numComps;
 
     // 3# Return indices
     std::vector<uint32> indices;
-    for ( size_t i = (writeStart / _typeComponents); i < (_atomEnd / _typeComponents); ++i ) {
+    for ( size_t i = writeStart; i < _size; ++i ) {
         indices.push_back( (uint32)i );
     }
 
     return indices;
 }
 
+template<typename VAL>
+void AttribVertexBuffer::set( size_t first, std::vector<VAL> objs )
+{
+    Guard( objs.size() > 0 ) return;
+    Requires( _sourceId == gl_id() );
+
+    std::vector<float> data = to_atoms( objs );
+    Requires( first + data.size() / _type.numComps <= size() );
+
+    native_write_at( (GLuint)(first * _type.byteSize), data );
+}
+
+template<typename VAL>
+std::vector<float> AttribVertexBuffer::to_atoms( const std::vector<VAL>& objs )
+{
+    std::vector<float> data;
+    data.reserve( objs.size() * _type.numComps );
 
+    // For float values just copy the data 1:1
+    if constexpr(std::is_same_v<VAL, float>) {
+        data.insert( data.end(), objs.begin(), objs.end() );
+    }
+    else {
+        for ( auto obj : objs ) write_into( data, obj );
+    }
+
+    // Plain floats have to add up to whole objects
+    Ensures( data.size() % _type.numComps == 0 );
+    return data;
+}
 
 ENGINE_NAMESPACE_END
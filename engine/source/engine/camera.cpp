@@ -16,6 +16,11 @@ Viewport4i& Camera::get_viewport()
     return _viewport;
 }
 
+optional<Rect4f> Camera::view_rect() const
+{
+    return std::nullopt;
+}
+
 Matrix4f& Camera::proj_view_mat4()
 {
     return _projViewMat4;
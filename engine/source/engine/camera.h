@@ -11,6 +11,7 @@
 #include "events.h"
 
 #include "matrix4f.h"
+#include "rect4f.h"
 #include "logger.h"
 #include "viewport4.h"
 
@@ -20,6 +21,9 @@ class Camera : public noncopyable
 {
 public:
     virtual void        activate(float delta) = 0;
+
+    // What activate() made visible, in world space. Cameras without one see everything.
+    virtual optional<Rect4f> view_rect() const;
         
             void        set_viewport( Viewport4i viewport );
 
@@ -5,7 +5,9 @@ ENGINE_NAMESPACE_BEGIN
 
 Camera2D::Camera2D() : 
     _target(0,0,1), 
-    _zoom(1)
+    _zoom(1),
+    _right(1),
+    _top(1)
 {
 }
 
@@ -35,6 +37,11 @@ void Camera2D::activate( float delta )
     glViewport( viewport.x, viewport.y, viewport.w, viewport.h );
 }
 
+optional<Rect4f> Camera2D::view_rect() const
+{
+    return Rect4f::from_min_max( _lastTarget.x - _right, _lastTarget.y - _top, _lastTarget.x + _right, _lastTarget.y + _top );
+}
+
 void Camera2D::set_target( Vector3f target )
 {
     _target.x = target.x;
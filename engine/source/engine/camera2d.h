@@ -24,6 +24,9 @@ public:
     
     void        activate(float delta) override;
 
+    // Around the target the last activate() moved to, _right and _top to each side
+    optional<Rect4f> view_rect() const override;
+
     void        set_target( Vector3f target );
     Vector3f    get_target();
 
@@ -0,0 +1,54 @@
+#include "stdafx.h"
+#include "camerauniforms.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                     Public Static                      */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+const char* CameraUniforms::BLOCK_NAME = "Camera";
+
+string CameraUniforms::glsl()
+{
+    return string( "layout(std140) uniform " ) + BLOCK_NAME + " {\n"
+         + "    mat4 uni_projview;\n"
+         + "    vec4 uni_viewport;\n"
+         + "};\n";
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Public                         */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+CameraUniforms::CameraUniforms() : _id( 0 )
+{
+    glGenBuffers( 1, &_id );
+    GLStateCache::instance().bind_buffer( GL_UNIFORM_BUFFER, _id );
+    glBufferData( GL_UNIFORM_BUFFER, sizeof( Block ), nullptr, GL_DYNAMIC_DRAW );
+}
+
+CameraUniforms::~CameraUniforms()
+{
+    glDeleteBuffers( 1, &_id );
+    GLStateCache::instance().forget_buffer( _id );
+}
+
+void CameraUniforms::update( Camera& camera )
+{
+    Block block;
+    std::memcpy( block.projView, camera.proj_view_mat4().data(), sizeof( block.projView ) );
+
+    Viewport4i& viewport = camera.get_viewport();
+    block.viewport[0] = (float)viewport.x;
+    block.viewport[1] = (float)viewport.y;
+    block.viewport[2] = (float)viewport.w;
+    block.viewport[3] = (float)viewport.h;
+
+    // Same matrix layout as Shader::set_uniform, the block's mat4 is column major by default
+    GLStateCache::instance().bind_buffer( GL_UNIFORM_BUFFER, _id );
+    glBufferSubData( GL_UNIFORM_BUFFER, 0, sizeof( Block ), &block );
+    glBindBufferBase( GL_UNIFORM_BUFFER, BINDING, _id );
+}
+
+ENGINE_NAMESPACE_END
@@ -0,0 +1,56 @@
+#pragma once
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                        Includes                        */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+// Std-Includes
+#include <cstring>
+
+// Other Includes
+
+// Internal Includes
+#include "_gl.h"
+#include "_global.h"
+#include "noncopyable.h"
+#include "camera.h"
+#include "matrix4f.h"
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Class                          */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+ENGINE_NAMESPACE_BEGIN
+
+// Per-camera shader data in one std140 uniform buffer.
+//
+// Every generated vertex shader declares the block from glsl() and links
+// it to BINDING, so a camera pass uploads its data once and all shaders
+// read it from there. Renderers only set their own model matrix.
+//
+//    cameraUniforms.update( camera );   // per camera, before its renderers
+class CameraUniforms : public noncopyable
+{
+public:
+    static const GLuint BINDING = 0;
+    static const char*  BLOCK_NAME;
+
+    // GLSL declaration of the block, matching Block below
+    static string       glsl();
+
+            CameraUniforms();
+            ~CameraUniforms();
+
+    // Uploads the camera's data and binds the buffer to BINDING
+    void    update( Camera& camera );
+
+private:
+    // std140: mat4 is four vec4 columns, vec4 is 16 bytes
+    struct Block {
+        float projView[16];
+        float viewport[4];
+    };
+
+    GLuint  _id;
+};
+
+ENGINE_NAMESPACE_END
@@ -0,0 +1,34 @@
+#include "stdafx.h"
+#include "changelog.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Public                         */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+PoolChanges::PoolChanges()
+    : _changedTick( 0 )
+{
+
+}
+
+void PoolChanges::push( entity_id id )
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+
+    _log.push( id );
+    _changedTick = Component::current_tick();
+}
+
+tick_t PoolChanges::changed_tick() const
+{
+    return _changedTick;
+}
+
+bool PoolChanges::covers( tick_t tick ) const
+{
+    return _log.covers( tick );
+}
+
+ENGINE_NAMESPACE_END
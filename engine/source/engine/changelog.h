@@ -0,0 +1,147 @@
+#pragma once
+
+// Std-Includes
+#include <deque>
+#include <mutex>
+
+// Other Includes
+
+// Internal Includes
+#include "_global.h"
+#include "component.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+// Fine-grained companion to Component::mark_changed(), records what
+// changed and when, so consumers can apply O(edits) updates:
+//
+//    if ( log.covers( seenTick ) )
+//        log.each_since( seenTick, [&]( const TileEdit& e ) { ... } );
+//    else
+//        rebuild_everything();
+//
+// Entries older than HISTORY_TICKS are dropped. A consumer that has been
+// away longer than that is told so by covers() and has to do a full
+// resync. The same holds after clear(), e.g. on a reshape.
+template<typename EVENT, tick_t HISTORY = 64>
+class ChangeLog
+{
+public:
+    static const tick_t HISTORY_TICKS = HISTORY;
+
+            ChangeLog();
+
+    void    push( EVENT event );
+    void    clear();
+
+    // True if every change after tick is still in the log
+    bool    covers( tick_t tick ) const;
+
+    template<typename FUNC>
+    void    each_since( tick_t tick, FUNC&& func ) const;
+
+private:
+    void    trim();
+
+    struct Entry {
+        tick_t tick;
+        EVENT  event;
+    };
+
+    std::deque<Entry>   _entries;
+
+    // Changes up to and including this tick may be missing
+    tick_t              _incompleteUntil;
+};
+
+template<typename EVENT, tick_t HISTORY>
+ChangeLog<EVENT, HISTORY>::ChangeLog()
+    : _incompleteUntil( Component::current_tick() )
+{
+}
+
+template<typename EVENT, tick_t HISTORY>
+void ChangeLog<EVENT, HISTORY>::push( EVENT event )
+{
+    trim();
+    _entries.push_back( { Component::current_tick(), std::move( event ) } );
+}
+
+template<typename EVENT, tick_t HISTORY>
+void ChangeLog<EVENT, HISTORY>::clear()
+{
+    _entries.clear();
+    _incompleteUntil = Component::current_tick();
+}
+
+template<typename EVENT, tick_t HISTORY>
+bool ChangeLog<EVENT, HISTORY>::covers( tick_t tick ) const
+{
+    return tick >= _incompleteUntil;
+}
+
+template<typename EVENT, tick_t HISTORY>
+template<typename FUNC>
+void ChangeLog<EVENT, HISTORY>::each_since( tick_t tick, FUNC&& func ) const
+{
+    Requires( covers( tick ) );
+
+    // Entries are ordered by tick, walk back to the first newer one
+    auto it = _entries.end();
+    while ( it != _entries.begin() && std::prev( it )->tick > tick )
+        --it;
+
+    for ( ; it != _entries.end(); ++it )
+        func( it->event );
+}
+
+template<typename EVENT, tick_t HISTORY>
+void ChangeLog<EVENT, HISTORY>::trim()
+{
+    tick_t now = Component::current_tick();
+    Guard( now > HISTORY_TICKS ) return;
+
+    tick_t horizon = now - HISTORY_TICKS;
+    while ( !_entries.empty() && _entries.front().tick <= horizon ) {
+        _incompleteUntil = std::max( _incompleteUntil, _entries.front().tick );
+        _entries.pop_front();
+    }
+}
+
+// The entities whose component changed in one pool, each at most once per
+// tick. Every COMPONENT type has one, fed by mark_changed() and add(), so
+// "what changed in this pool since tick N" walks the changes, not the pool:
+//
+//    if ( CTransform::get_changes().covers( seenTick ) )
+//        CTransform::get_changes().each_since( seenTick, [&]( entity_id id ) { ... } );
+//
+// Removed components are not reported, consumers check the entity still has
+// one. Pushed from system jobs running in parallel, read between ticks.
+class PoolChanges : public noncopyable
+{
+public:
+            PoolChanges();
+
+    void    push( entity_id id );
+
+    // Last tick anything in the pool changed
+    tick_t  changed_tick() const;
+
+    bool    covers( tick_t tick ) const;
+
+    template<typename FUNC>
+    void    each_since( tick_t tick, FUNC&& func ) const;
+
+private:
+    std::mutex              _mutex;
+    ChangeLog<entity_id>    _log;
+    tick_t                  _changedTick;
+};
+
+template<typename FUNC>
+void PoolChanges::each_since( tick_t tick, FUNC&& func ) const
+{
+    _log.each_since( tick, std::forward<FUNC>( func ) );
+}
+
+ENGINE_NAMESPACE_END
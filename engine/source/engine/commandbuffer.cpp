@@ -0,0 +1,91 @@
+#include "stdafx.h"
+#include "commandbuffer.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                      Public Static                     */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+std::mutex                      CommandBuffer::REGISTRY_MUTEX;
+std::vector<CommandBuffer*>     CommandBuffer::BUFFERS;
+std::vector<CommandBuffer::Command> CommandBuffer::ORPHANED;
+atomic<uint64>                  CommandBuffer::NEXT_SEQUENCE = 0;
+
+CommandBuffer& CommandBuffer::local()
+{
+    thread_local CommandBuffer BUFFER;
+    return BUFFER;
+}
+
+void CommandBuffer::playback_all()
+{
+    std::vector<Command> commands;
+
+    {
+        std::lock_guard<std::mutex> lock( REGISTRY_MUTEX );
+
+        commands = std::move( ORPHANED );
+        ORPHANED.clear();
+
+        for ( CommandBuffer* buffer : BUFFERS ) {
+            std::move( buffer->_commands.begin(), buffer->_commands.end(), std::back_inserter( commands ) );
+            buffer->_commands.clear();
+        }
+    }
+
+    Guard( !commands.empty() ) return;
+
+    // One entity at a time in ascending ids, its commands in recording order
+    std::sort( commands.begin(), commands.end(), []( const Command& a, const Command& b ) {
+        return a.entity != b.entity ? a.entity < b.entity : a.sequence < b.sequence;
+    } );
+
+    for ( Command& command : commands )
+        command.apply();
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Public                         */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+CommandBuffer::CommandBuffer()
+{
+    std::lock_guard<std::mutex> lock( REGISTRY_MUTEX );
+    BUFFERS.push_back( this );
+}
+
+CommandBuffer::~CommandBuffer()
+{
+    std::lock_guard<std::mutex> lock( REGISTRY_MUTEX );
+    BUFFERS.erase( std::find( BUFFERS.begin(), BUFFERS.end(), this ) );
+
+    // The thread is gone, its commands are still due
+    std::move( _commands.begin(), _commands.end(), std::back_inserter( ORPHANED ) );
+}
+
+Entity CommandBuffer::spawn()
+{
+    return Entity::New();
+}
+
+void CommandBuffer::destroy( Entity entity )
+{
+    entity.destroy();
+}
+
+size_t CommandBuffer::size() const
+{
+    return _commands.size();
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Private                        */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+void CommandBuffer::record( Entity entity, function<void()> apply )
+{
+    _commands.push_back( { entity.id(), NEXT_SEQUENCE++, std::move( apply ) } );
+}
+
+ENGINE_NAMESPACE_END
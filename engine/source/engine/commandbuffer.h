@@ -0,0 +1,91 @@
+#pragma once
+
+// Std-Includes
+#include <mutex>
+
+// Other Includes
+
+// Internal Includes
+#include "_global.h"
+#include "entity.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+// Deferred structural changes for code that runs while pools are being
+// iterated, i.e. inside systems. Each thread records into its own buffer
+// without locking:
+//
+//    CommandBuffer& cmd = CommandBuffer::local();
+//    Entity bullet = cmd.spawn();
+//    cmd.add<CTransform>( bullet, [=]( CTransform& t ) { t.position() = origin; } );
+//    cmd.remove<CControllable>( target );
+//
+// LogicEngine plays all buffers back after the systems of a tick are done.
+// Commands are applied grouped by entity, in ascending id order. The
+// commands of one entity run in the order they were recorded, across pools
+// and threads, so "remove A, then add B" stays in that order. Commands on
+// different entities must not rely on running in recording order.
+//
+// spawn() hands out the id right away, destroy() goes through the regular
+// end-of-tick destroy queue. Commands on entities that died before the
+// playback are dropped.
+class CommandBuffer : public noncopyable
+{
+public:
+    static CommandBuffer& local();
+
+    // Applies and clears the commands of all threads, main thread only
+    static void     playback_all();
+
+            CommandBuffer();
+            ~CommandBuffer();
+
+    Entity  spawn();
+    void    destroy( Entity entity );
+
+    template<typename COMPONENT>
+    void    add( Entity entity, function<void( COMPONENT& )> init = nullptr );
+
+    template<typename COMPONENT>
+    void    remove( Entity entity );
+
+    size_t  size() const;
+
+private:
+    struct Command {
+        entity_id       entity;
+        uint64          sequence;   // Recording order over all threads
+        function<void()> apply;
+    };
+
+    void            record( Entity entity, function<void()> apply );
+
+    std::vector<Command>    _commands;
+
+    static std::mutex                   REGISTRY_MUTEX;
+    static std::vector<CommandBuffer*>  BUFFERS;
+    static std::vector<Command>         ORPHANED;
+    static atomic<uint64>               NEXT_SEQUENCE;
+};
+
+template<typename COMPONENT>
+void CommandBuffer::add( Entity entity, function<void( COMPONENT& )> init )
+{
+    record( entity, [entity, init]() mutable {
+        Guard( entity.alive() ) return;
+
+        COMPONENT& component = entity.add<COMPONENT>();
+        if ( init ) init( component );
+    } );
+}
+
+template<typename COMPONENT>
+void CommandBuffer::remove( Entity entity )
+{
+    record( entity, [entity]() mutable {
+        Guard( entity.alive() ) return;
+        entity.remove<COMPONENT>();
+    } );
+}
+
+ENGINE_NAMESPACE_END
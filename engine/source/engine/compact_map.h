@@ -3,8 +3,8 @@
 #include <algorithm>
 #include <vector>
 #include <memory>
-#include <map>
-#include <optional>
+#include <cstdint>
+#include <type_traits>
 #include "noncopyable.h"
 #include "owner.h"
 
@@ -17,28 +17,44 @@
 //
 // Tradeoffs:
 //  - increased memory space usage
-//  - slower inserts & removes
+//  - iteration order is not stable, removes swap the last element into the gap
 //
 // Assumptions:
-//  - Stored data will be significantly larger than the keys, 
+//  - Keys are integral ids that are handed out densely (e.g. entity ids),
+//    therefore the sparse index is paged and only allocates touched pages
+//  - Only the lower 32 bits of a key address the sparse index, the upper
+//    bits may carry a generation. Lookups compare the full key, so a stale
+//    generation is not found. Putting a key whose index is held by another
+//    generation is a precondition failure, remove the old key first
+//  - Stored data will be significantly larger than the keys,
 //    therefore value capacity is flexible and dynamically grows
+//
+// Layout (sparse set):
+//
+//   sparse pages:  key -> slot       [page 0][page 1][ null ][page 3] ...
+//   dense keys:    slot -> key       [ k0 ][ k1 ][ k2 ] ...
+//   dense values:  slot -> value     [ v0 ][ v1 ][ v2 ] ...
+//
+//  has/get/remove are O(1), values() stays contiguous.
 
 struct compact_map_t {
     virtual ~compact_map_t() = default;
+
+    // Type-erased remove(), for owners that only know the key type
+    virtual void erase( std::uint64_t key ) = 0;
 };
 
 template<typename K, typename V>
 class compact_map : public compact_map_t
 {
+    static_assert(std::is_integral<K>::value, "compact_map keys must be integral ids");
+
 public:
     // Enabled:
-    compact_map();
-    compact_map( compact_map<K, V>&& );
-    compact_map& operator=( compact_map<K,V>&& );
-    ~compact_map() {
-        delete _values;
-        delete _keys;
-    };
+    compact_map() = default;
+    compact_map( compact_map<K, V>&& ) = default;
+    compact_map& operator=( compact_map<K,V>&& ) = default;
+    ~compact_map() = default;
 
     // Disabled:
     compact_map( const compact_map& ) = delete;               // Copy-Constructor
@@ -47,99 +63,208 @@ public:
     V&      put( K key, V value );
     V&      emplace(K key, V&& value);
     V&      access( K key );
+    V*      try_access( K key );
+    const V* try_access( K key ) const;
     void    remove( K key );
-    bool    contains( K key );
+    void    clear();
+    void    erase( std::uint64_t key ) override;
+    bool    contains( K key ) const;
+    size_t  size() const;
+    size_t  capacity() const;
+    void    reserve( size_t capacity );
 
-    std::vector<V>& values();
+    std::vector<V>&       values();
+    const std::vector<V>& values() const;
+    const std::vector<K>& keys() const;
 
 private:
-    // Values
-    std::vector<V>*      _values;
-    std::map<K, size_t>* _keys;
+    typedef std::uint32_t slot_t;
 
-    static void         __move_state( compact_map<K,V>& dest, compact_map<K, V>& src );
-};
+    static constexpr size_t PAGE_BITS = 12;
+    static constexpr size_t PAGE_SIZE = size_t(1) << PAGE_BITS;
+    static constexpr slot_t NO_SLOT   = ~slot_t(0);
 
-template<typename K, typename V>
-compact_map<K,V>::compact_map() {
-    _values = new std::vector<V>();
-    _keys = new std::map<K, size_t>();
-}
+    static size_t       sparse_index( K key );
+
+    slot_t              find_slot( K key ) const;
+    slot_t&             assure_slot( K key );
+
+    // Sparse index, paged to keep memory proportional to the touched id range
+    std::vector<std::unique_ptr<slot_t[]>> _pages;
+
+    // Dense storage, _keys[i] belongs to _values[i]
+    std::vector<K>      _keys;
+    std::vector<V>      _values;
+};
 
 template<typename K, typename V>
 V& compact_map<K, V>::put( K key, V value )
 {
-    _values->push_back( value );
-    _keys->insert( std::pair<K, size_t>( key, _values->size()-1 ) );
-    
-    return access( key );
+    return emplace( key, std::move( value ) );
 }
 
 template<typename K, typename V>
 V& compact_map<K, V>::emplace(K key, V&& value)
 {
-  _values->emplace_back( std::move( value ));
-  _keys->insert(std::pair<K, size_t>(key, _values->size() - 1));
+    slot_t& slot = assure_slot( key );
 
-  return access(key);
+    if ( slot != NO_SLOT ) {
+        Requires( _keys[slot] == key );
+        _values[slot] = std::move( value );
+        return _values[slot];
+    }
+
+    slot = (slot_t)_values.size();
+    _keys.push_back( key );
+    _values.emplace_back( std::move( value ) );
+
+    return _values.back();
 }
 
 template<typename K, typename V>
 V& compact_map<K, V>::access( K key )
 {
-    auto& index = (*_keys)[key];
-    auto& value = (*_values)[index];
+    slot_t slot = find_slot( key );
+    Requires( slot != NO_SLOT );
 
-    return value;
+    return _values[slot];
 }
 
 template<typename K, typename V>
-void compact_map<K, V>::remove( K key )
+V* compact_map<K, V>::try_access( K key )
 {
-    if ( _keys->erase( key ) == 0 )
-        return;
+    slot_t slot = find_slot( key );
+    Guard( slot != NO_SLOT ) return nullptr;
 
-    size_t index = _keys->find( key );
-    _values->erase( _values.begin() + index );
+    return &_values[slot];
+}
+
+template<typename K, typename V>
+const V* compact_map<K, V>::try_access( K key ) const
+{
+    slot_t slot = find_slot( key );
+    Guard( slot != NO_SLOT ) return nullptr;
+
+    return &_values[slot];
+}
+
+template<typename K, typename V>
+void compact_map<K, V>::remove( K key )
+{
+    slot_t slot = find_slot( key );
+    Guard( slot != NO_SLOT ) return;
 
-    for ( auto& pair : *_keys ) {
-        if ( pair.second > index )
-            pair.second--;
+    // Swap the last element into the gap and pop the back
+    slot_t last = (slot_t)_values.size() - 1;
+    if ( slot != last ) {
+        _values[slot] = std::move( _values[last] );
+        _keys[slot]   = _keys[last];
+        assure_slot( _keys[slot] ) = slot;
     }
+
+    _values.pop_back();
+    _keys.pop_back();
+    assure_slot( key ) = NO_SLOT;
+}
+
+// Only resets the sparse entries that are in use, pages and dense capacity are kept for refilling
+template<typename K, typename V>
+void compact_map<K, V>::clear()
+{
+    for ( K key : _keys )
+        assure_slot( key ) = NO_SLOT;
+
+    _keys.clear();
+    _values.clear();
 }
 
 template<typename K, typename V>
-bool compact_map<K, V>::contains( K key )
+void compact_map<K, V>::erase( std::uint64_t key )
 {
-    return _keys->count(key) > 0;
+    remove( (K)key );
+}
+
+template<typename K, typename V>
+bool compact_map<K, V>::contains( K key ) const
+{
+    return find_slot( key ) != NO_SLOT;
+}
+
+template<typename K, typename V>
+size_t compact_map<K, V>::size() const
+{
+    return _values.size();
+}
+
+template<typename K, typename V>
+size_t compact_map<K, V>::capacity() const
+{
+    return _values.capacity();
+}
+
+// Grows dense storage once up front, for callers that know how many puts follow
+template<typename K, typename V>
+void compact_map<K, V>::reserve( size_t capacity )
+{
+    _keys.reserve( capacity );
+    _values.reserve( capacity );
 }
 
 template<typename K, typename V>
 std::vector<V>& compact_map<K, V>::values()
 {
-    return *_values;
+    return _values;
 }
 
-#pragma region Move Semantics
 template<typename K, typename V>
-compact_map<K, V>::compact_map( compact_map<K,V>&& o )
+const std::vector<V>& compact_map<K, V>::values() const
 {
-    __move_state( this, o );
+    return _values;
 }
 
 template<typename K, typename V>
-compact_map<K, V>& compact_map<K, V>::operator=( compact_map<K,V>&& o )
+const std::vector<K>& compact_map<K, V>::keys() const
 {
-    __move_state( this, o );
-    return this;
+    return _keys;
 }
 
 template<typename K, typename V>
-void compact_map<K, V>::__move_state( compact_map<K, V>& dest, compact_map<K, V>& src ) {
-    dest._values = src._values;
-    src._values = nullptr;
+size_t compact_map<K, V>::sparse_index( K key )
+{
+    return (size_t)((std::uint64_t)key & 0xFFFFFFFFu);
+}
+
+template<typename K, typename V>
+typename compact_map<K, V>::slot_t compact_map<K, V>::find_slot( K key ) const
+{
+    size_t index = sparse_index( key );
+    size_t page  = index >> PAGE_BITS;
+
+    if ( page >= _pages.size() || _pages[page] == nullptr )
+        return NO_SLOT;
+
+    slot_t slot = _pages[page][index & (PAGE_SIZE - 1)];
+
+    // The sparse entry may belong to another generation of the same index
+    if ( slot == NO_SLOT || _keys[slot] != key )
+        return NO_SLOT;
+
+    return slot;
+}
+
+template<typename K, typename V>
+typename compact_map<K, V>::slot_t& compact_map<K, V>::assure_slot( K key )
+{
+    size_t index = sparse_index( key );
+    size_t page  = index >> PAGE_BITS;
+
+    if ( page >= _pages.size() )
+        _pages.resize( page + 1 );
+
+    if ( _pages[page] == nullptr ) {
+        _pages[page].reset( new slot_t[PAGE_SIZE] );
+        std::fill( _pages[page].get(), _pages[page].get() + PAGE_SIZE, NO_SLOT );
+    }
 
-    dest._keys = src._keys;
-    dest._keys = nullptr;
+    return _pages[page][index & (PAGE_SIZE - 1)];
 }
-#pragma endregion
\ No newline at end of file
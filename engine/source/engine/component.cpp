@@ -3,7 +3,43 @@
 
 ENGINE_NAMESPACE_BEGIN
 
+atomic<tick_t> Component::CURRENT_TICK = 1;
 
+Component::Component()
+  : _changedTick( CURRENT_TICK )
+{
+
+}
+
+bool Component::mark_changed()
+{
+  // Components are written by one job at a time, no race on the stamp
+  tick_t now = CURRENT_TICK;
+  Guard( _changedTick != now ) return false;
+
+  _changedTick = now;
+  return true;
+}
+
+tick_t Component::changed_tick() const
+{
+  return _changedTick;
+}
+
+bool Component::changed_since( tick_t tick ) const
+{
+  return _changedTick > tick;
+}
+
+tick_t Component::current_tick()
+{
+  return CURRENT_TICK;
+}
+
+void Component::advance_tick()
+{
+  CURRENT_TICK++;
+}
 
 ENGINE_NAMESPACE_END
 
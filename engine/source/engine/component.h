@@ -12,11 +12,31 @@
 
 ENGINE_NAMESPACE_BEGIN
 
+// Logic tick counter, advanced by LogicEngine at every tick start
+typedef uint64 tick_t;
+
 class Component : public noncopyable {
 public:
   Entity  entity;
 
+  Component();
+
   virtual void    update( float delta ) = 0;
+
+  // Change tracking: writers stamp the component, consumers remember the
+  // tick they last looked at and ask for anything newer. COMPONENTs also
+  // report to their pool's PoolChanges, true the first time in a tick.
+  bool    mark_changed();
+  tick_t  changed_tick() const;
+  bool    changed_since( tick_t tick ) const;
+
+  static tick_t current_tick();
+  static void   advance_tick();
+
+private:
+  tick_t  _changedTick;
+
+  static atomic<tick_t> CURRENT_TICK;
 };
 
 #define COMPONENT(NAME, PRIORITY) \
@@ -24,9 +44,21 @@ public:
   public: \
 		static compact_map<entity_id, NAME>& get_all_components() { \
 		  static compact_map<entity_id, NAME> ALL_INSTANCES; \
+		  static bool REGISTERED = Entity::register_pool( ALL_INSTANCES ); \
 		  return ALL_INSTANCES; \
-		};
+		}; \
+		static PoolChanges& get_changes() { \
+		  static PoolChanges CHANGES; \
+		  return CHANGES; \
+		}; \
+		void mark_changed() { \
+		  if ( Component::mark_changed() ) get_changes().push( entity.id() ); \
+		} \
+		static constexpr int32 get_priority() { return PRIORITY; }
 
 #define END };
 
-ENGINE_NAMESPACE_END
\ No newline at end of file
+ENGINE_NAMESPACE_END
+
+// Last, it needs Component and COMPONENT needs its PoolChanges
+#include "changelog.h"
\ No newline at end of file
@@ -4,22 +4,24 @@
 ENGINE_NAMESPACE_BEGIN
 
 void CControllable::update( float delta ) {
-    if ( entity.has<CTransform>() ) {
-        Vector2f dirSpeed = Vector2f( 0, 0 );
-
-        if ( moveUp )    dirSpeed.y += 1;
-        if ( moveDown )  dirSpeed.y -= 1;
-        if ( moveLeft )  dirSpeed.x -= 1;
-        if ( moveRight ) dirSpeed.x += 1;
+    if ( CTransform* transform = entity.try_get<CTransform>() ) {
+        update( delta, *transform );
+    }
+}
 
-        dirSpeed = dirSpeed.normalized() * moveSpeed * delta;
+void CControllable::update( float delta, CTransform& transform ) {
+    Vector2f dirSpeed = Vector2f( 0, 0 );
 
+    if ( moveUp )    dirSpeed.y += 1;
+    if ( moveDown )  dirSpeed.y -= 1;
+    if ( moveLeft )  dirSpeed.x -= 1;
+    if ( moveRight ) dirSpeed.x += 1;
 
-        CTransform& transform = entity.get<CTransform>();
+    dirSpeed = dirSpeed.normalized() * moveSpeed * delta;
 
-        transform.position.x += dirSpeed.x;
-        transform.position.y += dirSpeed.y;
-    }
+    Vector3f& position = transform.position();
+    position.x += dirSpeed.x;
+    position.y += dirSpeed.y;
 }
 
 ENGINE_NAMESPACE_END
@@ -14,6 +14,7 @@ ENGINE_NAMESPACE_BEGIN
 
 COMPONENT(CControllable, 90)
     void update( float delta );
+    void update( float delta, CTransform& transform );
 
   GLOBAL:
     int32   health = 0;
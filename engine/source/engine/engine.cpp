@@ -15,19 +15,30 @@ ENGINE_NAMESPACE_BEGIN
  *
  * @param config A configuration for the engine.
  */
-Engine::Engine()
+Engine::Engine( EngineConfig config ) : _config( config ), _running( false )
 {
+    Requires( config.ups > 0 );
+    Requires( config.maxTicksPerUpdate > 0 );
+
+    // A tick that takes longer than its own period cannot keep up
+    PerfStats::instance().set_tick_budget( std::chrono::microseconds( 1000000 / config.ups ) );
+
+    // Engines below may hand work to the workers, so they come first
+    _jobs      = make_owner<JobSystem>();
     _gameState = make_owner<TestGameState>();
 
-    _render  = make_owner<RenderEngine>();
-    _logic   = make_owner<LogicEngine>();
+    if ( !config.headless )
+        _render = make_owner<RenderEngine>( _jobs.get_non_owner() );
+
+    _logic   = make_owner<LogicEngine>( _jobs.get_non_owner(), !config.headless );
     _input   = make_owner<InputEngine>();
     _physics = make_owner<PhysicsEngine>();
     _network = make_owner<NetworkEngine>();
 
     // Post-Conditions
+    Ensures( _jobs != nullptr );
     Ensures( _gameState != nullptr );
-    Ensures( _render != nullptr );
+    Ensures( _render != nullptr || config.headless );
     Ensures( _input != nullptr );
     Ensures( _logic != nullptr );
     Ensures( _physics != nullptr );
@@ -43,19 +54,28 @@ int Engine::run() {
 
     // StartUp
     _input->on_start();
-    _render->on_start( _input.get_non_owner() );
+    if ( _render ) _render->on_start( _input.get_non_owner() );
     _logic->on_start();
     _physics->on_start();
     _network->on_start();
 
-    // Mainloop
-    mainloop();
+    // Mainloop, logic on its own thread, rendering stays on this one
+    _running = true;
+
+    if ( _render ) {
+        std::thread logicThread( &Engine::logicloop, this );
+        renderloop();
+        logicThread.join();
+    }
+    else {
+        logicloop();
+    }
 
     // Shutdown
     _network->on_shutdown();
     _physics->on_shutdown();
     _logic->on_shutdown();
-    _render->on_shutdown();
+    if ( _render ) _render->on_shutdown();
     _input->on_shutdown();
 
     return 0;
@@ -65,51 +85,90 @@ int Engine::run() {
 /*                         Private                        */
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
-void Engine::mainloop() {
+void Engine::logicloop() {
 
-    uint64 fps = 144;
-    uint64 ups = 50;
+    FramePacer pacer( _config.ups );
 
-    uint64 elapsed = 0;
+    uint64 timePerUpdate = pacer.period_ns();
     uint64 lagUpdate = 0;
-    uint64 lagFrame = 0;
-    uint64 timePerUpdate = 1000 / ups;
-    uint64 timePerFrame = 1000 / fps;
+    float  delta = timePerUpdate * 1e-9f;
 
-    float  delta = timePerUpdate * 0.001f;
-
-    StopWatch timer;
+    uint64 last = FramePacer::now_ns();
 
     while (1)
     {
         // 1# Timing
-        elapsed = timer.tick();
-        lagUpdate += elapsed;
-        lagFrame  += elapsed;
+        uint64 now = FramePacer::now_ns();
+        lagUpdate += now - last;
+        last = now;
 
-        // 2# Logic
-        while ( lagUpdate >= timePerUpdate )
+        // 2# Logic, capped so a stall cannot snowball into a burst of ticks
+        for ( uint32 ticks = 1; lagUpdate >= timePerUpdate; ++ticks )
         {
+            float tickDelta = delta;
+
+            // 2.1# Last tick allowed this round, deal with what is still due
+            uint64 excess = lagUpdate / timePerUpdate - 1;
+            if ( ticks == _config.maxTicksPerUpdate && excess > 0 ) {
+                uint64 merged = _config.overload == TickOverload::MERGE ? std::min<uint64>( excess, _config.maxTicksPerUpdate ) : 0;
+
+                tickDelta += merged * delta;
+                PerfStats::instance().ticks_merged( merged );
+                PerfStats::instance().ticks_dropped( excess - merged );
+
+                lagUpdate -= excess * timePerUpdate;
+            }
+
             PerfStats::instance().tick_start();
             _logic->on_tick_start();
             _input->on_update();
-            _logic->on_update( delta );
-            if ( !update_gamestate() ) return;
+            _logic->on_update( tickDelta );
+            if ( !update_gamestate() ) {
+                _running = false;
+                return;
+            }
+            _logic->on_tick_end();
             PerfStats::instance().tick_end();
 
             lagUpdate -= timePerUpdate;
         }
-        
-        // 3# Rendering         
-        if ( lagFrame >= timePerFrame ) {
-            PerfStats::instance().frame_start();
-            _gameState->on_frame_start();
-            _render->on_render( ((float)lagUpdate / (float)timePerUpdate) );
-            _gameState->on_frame_end();
-            PerfStats::instance().frame_end();
-
-            lagFrame -= timePerFrame;
-        }
+
+        // 3# Nothing to do until the next tick is due
+        pacer.wait_until( now + (timePerUpdate - lagUpdate) );
+    }
+}
+
+void Engine::renderloop() {
+
+    FramePacer pacer( _config.fps );
+
+    uint64 timePerUpdate = 1000000000ull / _config.ups;
+
+    while ( _running )
+    {
+        // 1# GL work queued by other threads, e.g. gamestate transitions
+        _jobs->run_main_jobs();
+
+        // 2# Timing, throttled while nobody can see the window
+        pacer.set_rate( _render->get_window()->is_visible() ? _config.fps : _config.hiddenFps );
+        pacer.wait_next();
+
+        // 3# Rendering
+        const RenderSnapshot& snapshot = _logic->acquire_snapshot();
+
+        // A snapshot moves from its previous to its own tick within one tick length after publishing
+        float interpolation = (float)(FramePacer::now_ns() - snapshot.published_ns()) / (float)timePerUpdate;
+        interpolation = std::min( std::max( interpolation, 0.0f ), 1.0f );
+
+        // Frames can come before the first start and after the last end
+        bool hooks = _gameState != nullptr && _gameState->get_status() == GameStateStatus::RUNNING;
+
+        PerfStats::instance().frame_start();
+        _render->set_snapshot( snapshot );
+        if ( hooks ) _gameState->on_frame_start();
+        _render->on_render( interpolation );
+        if ( hooks ) _gameState->on_frame_end();
+        PerfStats::instance().frame_end();
     }
 }
 
@@ -120,26 +179,46 @@ bool Engine::update_gamestate()
         _gameState->on_update();
     }	
 
-    // End Gamestate
-	if (_gameState != nullptr && _gameState->get_status() == GameStateStatus::FINISHED) {
-		_gameState->end();
-        _render->on_gamestate_end();
-        _logic->on_gamestate_end();
-		_gameState = _gameState->take_next_gamestate();
-	}
+    // Ending and starting gamestates creates and destroys GL resources
+    if (_gameState == nullptr || _gameState->get_status() == GameStateStatus::RUNNING)
+        return _gameState != nullptr;
+
+    run_on_render_thread( [this]() {
+        // End Gamestate
+        if (_gameState != nullptr && _gameState->get_status() == GameStateStatus::FINISHED) {
+            _gameState->end();
+            if ( _render ) _render->on_gamestate_end();
+            _logic->on_gamestate_end();
+            _gameState = _gameState->take_next_gamestate();
+        }
 
-    // Start Gamestate
-	if (_gameState != nullptr && _gameState->get_status() == GameStateStatus::READY) {
-        _gameState->set_renderengine( _render.get_non_owner() );
-        _gameState->set_inputengine( _input.get_non_owner() );
-        _gameState->set_logicengine( _logic.get_non_owner() );
+        // Start Gamestate
+        if (_gameState != nullptr && _gameState->get_status() == GameStateStatus::READY) {
+            _gameState->set_renderengine( _render.get_non_owner() );
+            _gameState->set_inputengine( _input.get_non_owner() );
+            _gameState->set_logicengine( _logic.get_non_owner() );
 
-		_gameState->start();
-	}
+            _gameState->start();
+        }
+    } );
 
     return _gameState != nullptr;
 }
 
+void Engine::run_on_render_thread( function<void()> job )
+{
+    // Headless, this is the only thread
+    if ( _render == nullptr ) {
+        job();
+        return;
+    }
+
+    // Helps the workers while the render thread gets around to it
+    JobCounter done;
+    _jobs->submit_main( std::move( job ), &done );
+    _jobs->wait( done );
+}
+
 uint64 Engine::get_current_ms()
 {
     return std::chrono::duration_cast< std::chrono::milliseconds >(
@@ -18,11 +18,23 @@
 #include "gamestate.h"
 #include "perfstats.h"
 #include "stopwatch.h"
+#include "engineconfig.h"
+#include "framepacer.h"
+#include "jobsystem.h"
 
 ENGINE_NAMESPACE_BEGIN
 
 /**
  * The main engine object.
+ *
+ * Ticks run on a logic thread, the main thread keeps the window and the
+ * GL context (GLFW requires both on the main thread) and renders the
+ * latest snapshot the logic thread published. Gamestate start and end
+ * create and destroy GL resources, so the logic thread puts them into the
+ * JobSystem's main queue and waits for the render thread to run them.
+ *
+ * In headless mode there is no render thread and no RenderEngine, the
+ * ticks run on the thread that called run().
  */
 class Engine
 {
@@ -31,7 +43,7 @@ public:
     const string  ENGINE_NAME       = "KerosineEngine";
     const string  ENGINE_VERSION    = "v0.0.1-indev";
 
-            Engine();
+            explicit Engine( EngineConfig config = EngineConfig() );
             ~Engine() = default;
 
     int run();
@@ -39,11 +51,16 @@ public:
 private:
 
     /*  METHODS */
-    void mainloop();
+    void logicloop();
+    void renderloop();
     bool update_gamestate();
     uint64 get_current_ms();
 
+    // Runs job on the render thread and blocks until it is done, logic thread only
+    void run_on_render_thread( function<void()> job );
+
     /*  VARIABLES */   
+    owner<JobSystem>     _jobs;
     owner<RenderEngine>  _render;
     owner<LogicEngine>   _logic;
     owner<InputEngine>   _input;
@@ -52,6 +69,9 @@ private:
 
     owner<GameState>     _gameState;
 
+    EngineConfig         _config;
+    atomic<bool>         _running;
+
 };
 
 ENGINE_NAMESPACE_END
@@ -0,0 +1,71 @@
+#pragma once
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                        Includes                        */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+// Std-Includes
+#include <algorithm>
+#include <cstdlib>
+
+// Other Includes
+
+// Internal Includes
+#include "_global.h"
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Class                          */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+ENGINE_NAMESPACE_BEGIN
+
+// What the logic loop does with ticks beyond EngineConfig::maxTicksPerUpdate
+enum class TickOverload {
+    DROP,   /* Skip them, game time falls behind wall time */
+    MERGE   /* Fold them into the last tick's delta, up to maxTicksPerUpdate more */
+};
+
+struct EngineConfig {
+    // No window, no GL context and no RenderEngine at all. Gamestates get
+    // an empty render engine and the logic ticks run on the calling thread,
+    // e.g. for dedicated servers and benchmarks.
+    bool    headless = false;
+
+    // Logic ticks per second
+    uint32  ups = 50;
+
+    // Frames per second, 0 leaves pacing to vsync
+    uint32  fps = 144;
+
+    // Frames per second while the window is minimized or hidden
+    uint32  hiddenFps = 10;
+
+    // Catch-up ticks per wake-up after a stall, keeps a long hitch from
+    // turning into an ever growing burst of ticks
+    uint32          maxTicksPerUpdate = 5;
+    TickOverload    overload = TickOverload::DROP;
+
+    // Reads "--headless", "--ups <n>", "--fps <n>" and "--merge-ticks", unknown arguments are ignored
+    static EngineConfig from_args( int argc, char* argv[] );
+};
+
+inline EngineConfig EngineConfig::from_args( int argc, char* argv[] )
+{
+    EngineConfig config;
+
+    for ( int i = 1; i < argc; ++i ) {
+        string arg = argv[i];
+
+        if ( arg == "--headless" )
+            config.headless = true;
+        else if ( arg == "--ups" && i + 1 < argc )
+            config.ups = (uint32)std::max( 1, std::atoi( argv[++i] ) );
+        else if ( arg == "--fps" && i + 1 < argc )
+            config.fps = (uint32)std::max( 0, std::atoi( argv[++i] ) );
+        else if ( arg == "--merge-ticks" )
+            config.overload = TickOverload::MERGE;
+    }
+
+    return config;
+}
+
+ENGINE_NAMESPACE_END
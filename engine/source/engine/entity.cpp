@@ -3,12 +3,94 @@
 
 ENGINE_NAMESPACE_BEGIN
 
-std::atomic<entity_id> Entity::NEXT_ID = 1;
+std::mutex             Entity::REGISTRY_MUTEX;
+std::vector<uint32>    Entity::GENERATIONS = { 0 }; // Index 0 is reserved for Entity::None
+std::vector<uint32>    Entity::FREE_INDICES;
+std::vector<entity_id> Entity::DESTROY_QUEUE;
 Entity Entity::None = Entity(0);
 
 Entity Entity::New()
 {
-  return Entity(Entity::NEXT_ID++);
+  std::lock_guard<std::mutex> lock(REGISTRY_MUTEX);
+
+  uint32 index;
+  if (!FREE_INDICES.empty()) {
+    index = FREE_INDICES.back();
+    FREE_INDICES.pop_back();
+  }
+  else {
+    index = (uint32)GENERATIONS.size();
+    GENERATIONS.push_back(0);
+  }
+
+  return Entity(((entity_id)GENERATIONS[index] << 32) | index);
+}
+
+std::vector<Entity> Entity::New(size_t count)
+{
+  std::vector<Entity> entities;
+  entities.reserve(count);
+
+  std::lock_guard<std::mutex> lock(REGISTRY_MUTEX);
+
+  // Recycled indices first, then a single grow for the rest
+  while (entities.size() < count && !FREE_INDICES.empty()) {
+    uint32 index = FREE_INDICES.back();
+    FREE_INDICES.pop_back();
+    entities.push_back(Entity(((entity_id)GENERATIONS[index] << 32) | index));
+  }
+
+  uint32 first = (uint32)GENERATIONS.size();
+  GENERATIONS.resize(GENERATIONS.size() + (count - entities.size()), 0);
+
+  for (uint32 index = first; index < GENERATIONS.size(); ++index)
+    entities.push_back(Entity(index));
+
+  return entities;
+}
+
+void Entity::flush_destroyed()
+{
+  std::vector<entity_id> destroyed;
+  std::vector<compact_map_t*> registered;
+
+  // 1# Take the queue and the pools under the lock. The generation is bumped right
+  //    away, which also skips an entity destroyed twice in the same tick.
+  {
+    std::lock_guard<std::mutex> lock(REGISTRY_MUTEX);
+
+    for (entity_id id : DESTROY_QUEUE) {
+      Entity entity(id);
+      uint32 index = entity.index();
+
+      Guard(GENERATIONS[index] == entity.generation()) continue;
+
+      GENERATIONS[index]++;
+      destroyed.push_back(id);
+    }
+
+    DESTROY_QUEUE.clear();
+    registered = pools();
+  }
+
+  // 2# Erase without the lock, component destructors may use the registry
+  for (entity_id id : destroyed)
+    for (compact_map_t* pool : registered)
+      pool->erase(id);
+
+  // 3# Only now the indices can be handed out again
+  std::lock_guard<std::mutex> lock(REGISTRY_MUTEX);
+
+  for (entity_id id : destroyed)
+    FREE_INDICES.push_back(Entity(id).index());
+}
+
+bool Entity::register_pool(compact_map_t& pool)
+{
+  std::lock_guard<std::mutex> lock(REGISTRY_MUTEX);
+
+  pools().push_back(&pool);
+  return true;
 }
 
 Entity::Entity()
@@ -27,4 +109,30 @@ entity_id Entity::id() {
   return _id;
 }
 
+uint32 Entity::index() const {
+  return (uint32)(_id & 0xFFFFFFFFu);
+}
+
+uint32 Entity::generation() const {
+  return (uint32)(_id >> 32);
+}
+
+bool Entity::alive() const {
+  std::lock_guard<std::mutex> lock(REGISTRY_MUTEX);
+
+  return index() != 0 && index() < GENERATIONS.size() && GENERATIONS[index()] == generation();
+}
+
+void Entity::destroy() {
+  Requires(index() != 0);
+
+  std::lock_guard<std::mutex> lock(REGISTRY_MUTEX);
+  DESTROY_QUEUE.push_back(_id);
+}
+
+std::vector<compact_map_t*>& Entity::pools() {
+  static std::vector<compact_map_t*> POOLS;
+  return POOLS;
+}
+
 ENGINE_NAMESPACE_END
\ No newline at end of file
@@ -1,15 +1,20 @@
 #pragma once
 
 // Std-Includes
-#include <atomic>
+#include <mutex>
 // Other Includes
 
 // Internal Includes
 #include "_global.h"
 #include "idgen.h"
+#include "compact_map.h"
 
 ENGINE_NAMESPACE_BEGIN
 
+// Generational handle: [ generation : 32 | index : 32 ]
+//
+// Indices of destroyed entities are recycled, the generation is bumped on
+// every destroy, so handles to a destroyed entity never alias a new one.
 typedef uint64 entity_id;
 
 #define GLOBAL public
@@ -21,12 +26,25 @@ class Entity
 {
 public:
   static Entity New();
+  static std::vector<Entity> New(size_t count);
   static Entity None;
 
+  // Removes all entities queued by destroy() from every component pool, call once at the end of a tick
+  static void   flush_destroyed();
+
+  // Every COMPONENT pool registers itself here on first use, so destroy() can reach it
+  static bool   register_pool(compact_map_t& pool);
+
   Entity();
   explicit Entity(entity_id _id);
 
   entity_id id();
+  uint32    index() const;
+  uint32    generation() const;
+  bool      alive() const;
+
+  // Queues the entity for removal, components stay accessible until flush_destroyed()
+  void      destroy();
 
   // COMPONENT
   template<typename COMPONENT>
@@ -34,13 +52,15 @@ public:
     return COMPONENT::get_all_components().contains(_id);
   }
 
+  // Only on alive entities, a stale handle would take the slot of the entity that reuses its index
   template<typename COMPONENT>
   COMPONENT& add() {
+    Requires(alive());
+
     COMPONENT comp = COMPONENT();
     comp.entity = *this;
-    COMPONENT::get_all_components().emplace(_id, std::move(comp));
-
-    return get<COMPONENT>();
+    COMPONENT::get_changes().push(_id);
+    return COMPONENT::get_all_components().emplace(_id, std::move(comp));
   }
 
   template<typename COMPONENT>
@@ -48,16 +68,55 @@ public:
     return COMPONENT::get_all_components().access(_id);
   }
 
+  // Single lookup alternative to has<T>() + get<T>(), returns nullptr if absent
   template<typename COMPONENT>
-  COMPONENT& remove() {
-    return COMPONENT::get_all_components().remove(_id);
+  COMPONENT* try_get() {
+    return COMPONENT::get_all_components().try_access(_id);
+  }
+
+  template<typename COMPONENT>
+  void remove() {
+    Requires(alive());
+    COMPONENT::get_all_components().remove(_id);
+  }
+
+  // Spawns count entities with all COMPONENTS, growing every pool at most
+  // once up front. init( i, entity, components... ) sets up the i-th entity:
+  //
+  //   Entity::spawn_batch<CTransform, CControllable>( 1000,
+  //     []( size_t i, Entity e, CTransform& t, CControllable& c ) { t.position() = ...; } );
+  //
+  // Components are noncopyable, so there is no form taking prototypes.
+  template<typename... COMPONENTS, typename FUNC>
+  static std::vector<Entity> spawn_batch(size_t count, FUNC&& init) {
+    std::vector<Entity> entities = New(count);
+
+    (reserve_pool(COMPONENTS::get_all_components(), count), ...);
+
+    for (size_t i = 0; i < count; ++i) {
+      Entity entity = entities[i];
+      init(i, entity, entity.add<COMPONENTS>()...);
+    }
+
+    return entities;
   }
 
 private:
   entity_id _id;
 
-  static std::atomic<entity_id> NEXT_ID;
-  static std::vector<entity_id> ALL_ENTITIES;
+  // Doubles like push_back would, so waves of small batches don't copy the pool every time
+  template<typename POOL>
+  static void reserve_pool(POOL& pool, size_t count) {
+    Guard(pool.size() + count > pool.capacity()) return;
+    pool.reserve(std::max(pool.size() + count, 2 * pool.capacity()));
+  }
+
+  static std::mutex               REGISTRY_MUTEX;
+  static std::vector<uint32>      GENERATIONS;
+  static std::vector<uint32>      FREE_INDICES;
+  static std::vector<entity_id>   DESTROY_QUEUE;
+
+  static std::vector<compact_map_t*>& pools();
 };
 
 ENGINE_NAMESPACE_END
\ No newline at end of file
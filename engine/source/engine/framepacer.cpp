@@ -0,0 +1,101 @@
+#include "stdafx.h"
+#include "framepacer.h"
+
+#if defined(OS_WIN32) || defined(OS_WIN64)
+#   define WIN32_LEAN_AND_MEAN
+#   define NOMINMAX
+#   include <windows.h>
+#   include <timeapi.h>
+#endif
+
+ENGINE_NAMESPACE_BEGIN
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                      Public Static                     */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+uint64 FramePacer::now_ns()
+{
+    return std::chrono::duration_cast< std::chrono::nanoseconds >(
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Public                         */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+FramePacer::FramePacer( uint32 rate )
+    : _rate( 0 ), _periodNs( 0 ), _nextNs( now_ns() ), _oversleepNs( MIN_SLEEP_NS )
+{
+    set_rate( rate );
+
+#if defined(OS_WIN32) || defined(OS_WIN64)
+    timeBeginPeriod( 1 );
+#endif
+}
+
+FramePacer::~FramePacer()
+{
+#if defined(OS_WIN32) || defined(OS_WIN64)
+    timeEndPeriod( 1 );
+#endif
+}
+
+void FramePacer::set_rate( uint32 rate )
+{
+    Guard( rate != _rate ) return;
+
+    _rate     = rate;
+    _periodNs = rate > 0 ? 1000000000ull / rate : 0;
+    _nextNs   = now_ns() + _periodNs;
+}
+
+uint32 FramePacer::get_rate() const
+{
+    return _rate;
+}
+
+uint64 FramePacer::period_ns() const
+{
+    return _periodNs;
+}
+
+void FramePacer::wait_next()
+{
+    Guard( _periodNs > 0 ) return;
+
+    wait_until( _nextNs );
+
+    uint64 now = now_ns();
+    _nextNs += _periodNs;
+
+    if ( _nextNs + _periodNs < now )
+        _nextNs = now + _periodNs;
+}
+
+void FramePacer::wait_until( uint64 deadlineNs )
+{
+    // 1# One huge oversleep must not stop the sleeping for good, only sleeps
+    //    measure, and so decay, the estimate
+    _oversleepNs = std::min( _oversleepNs, _periodNs > 0 ? _periodNs / 2 : MAX_OVERSLEEP_NS );
+
+    // 2# Sleep while even a bad oversleep would still end before the deadline
+    uint64 now = now_ns();
+    while ( now + _oversleepNs + MIN_SLEEP_NS < deadlineNs ) {
+        std::this_thread::sleep_for( std::chrono::nanoseconds( MIN_SLEEP_NS ) );
+
+        uint64 after = now_ns();
+        uint64 overshoot = after - now > MIN_SLEEP_NS ? after - now - MIN_SLEEP_NS : 0;
+
+        // Jump up to new worst cases at once, forget old ones slowly
+        _oversleepNs = overshoot > _oversleepNs ? overshoot : _oversleepNs - (_oversleepNs - overshoot) / 64;
+        now = after;
+    }
+
+    // 3# Spin the rest
+    while ( now_ns() < deadlineNs )
+        std::this_thread::yield();
+}
+
+ENGINE_NAMESPACE_END
@@ -0,0 +1,63 @@
+#pragma once
+
+// Std-Includes
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+// Other Includes
+
+// Internal Includes
+#include "_global.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+// Keeps a loop at a fixed rate on steady_clock nanoseconds.
+//
+// Waiting sleeps while the deadline is further away than the OS has been
+// seen to oversleep, and spins (yielding) for the rest. The oversleep
+// estimate adapts per pacer, so a coarse system timer costs a little more
+// spinning instead of a missed deadline. On Windows the pacer raises the
+// system timer resolution to 1 ms while it exists, so a single sleep does
+// not overshoot by a whole 15.6 ms timer tick.
+//
+//    FramePacer pacer( 144 );
+//    while ( running ) {
+//        pacer.wait_next();
+//        render();
+//    }
+class FramePacer : public noncopyable
+{
+public:
+    static uint64   now_ns();
+
+    // 0 runs unpaced
+    explicit        FramePacer( uint32 rate );
+                    ~FramePacer();
+
+    void            set_rate( uint32 rate );
+    uint32          get_rate() const;
+    uint64          period_ns() const;
+
+    // Waits for the next period boundary. A loop that fell more than a
+    // period behind restarts from now instead of bursting to catch up.
+    void            wait_next();
+
+    // Sleep-then-spin until deadlineNs
+    void            wait_until( uint64 deadlineNs );
+
+private:
+    static constexpr uint64 MIN_SLEEP_NS = 1000000;
+
+    // Cap of the oversleep estimate without a period
+    static constexpr uint64 MAX_OVERSLEEP_NS = 16000000;
+
+    uint32          _rate;
+    uint64          _periodNs;
+    uint64          _nextNs;
+
+    // Worst recent overshoot of a MIN_SLEEP_NS sleep, decays slowly, at most half a period
+    uint64          _oversleepNs;
+};
+
+ENGINE_NAMESPACE_END
@@ -54,7 +54,8 @@ protected:
     void set_status( GameStateStatus status );
 
 private:
-    GameStateStatus				_status;
+    // Set from the logic thread and from frame hooks on the render thread
+    atomic<GameStateStatus>     _status;
 
     owner<GameState>			_nextGameState;
 
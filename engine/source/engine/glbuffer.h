@@ -39,6 +39,10 @@ public:
 
     GLuint  native_allocate( GLuint initCapacity );
 private:
+    // Element array bindings belong to the bound VAO, so uploads to index buffers go through
+    // the copy target and leave whichever VAO is bound untouched
+    static const GLenum WRITE_TARGET = TYPE == GL_ELEMENT_ARRAY_BUFFER ? GL_COPY_WRITE_BUFFER : TYPE;
+
     GLuint  _id;
 
     static Logger LOGGER;
@@ -53,7 +57,7 @@ void GLBuffer<T, TYPE>::native_create( GLuint initCapacity )
 template<typename T, GLuint TYPE>
 void GLBuffer<T, TYPE>::native_bind()
 {
-    glBindBuffer( TYPE, _id );
+    GLStateCache::instance().bind_buffer( TYPE, _id );
 }
 
 template<typename T, GLuint TYPE>
@@ -61,9 +65,8 @@ void GLBuffer<T, TYPE>::native_write_at( GLuint index, std::vector<T> data )
 {
     LOGGER.log( Level::DEBUG ) << "[" << _id << "] Write " << data.size() << " objects at [" << index << "]\n";
 
-    glBindBuffer( TYPE, _id );
-    glBufferSubData( TYPE, index, (GLuint)(data.size() * sizeof( T )), data.data());
-    glBindBuffer( TYPE, 0 );
+    GLStateCache::instance().bind_buffer( WRITE_TARGET, _id );
+    glBufferSubData( WRITE_TARGET, index, (GLuint)(data.size() * sizeof( T )), data.data());
 }
 
 template<typename T, GLuint TYPE>
@@ -73,19 +76,19 @@ void GLBuffer<T, TYPE>::native_copy( GLuint src, GLuint dest, GLuint length )
     GLuint tempId = native_allocate( length );
 
     // 2# Copy content into temporary VBO
-    glBindBuffer( GL_COPY_READ_BUFFER, _id );
-    glBindBuffer( GL_COPY_WRITE_BUFFER, tempId );
+    GLStateCache& gl = GLStateCache::instance();
+    gl.bind_buffer( GL_COPY_READ_BUFFER, _id );
+    gl.bind_buffer( GL_COPY_WRITE_BUFFER, tempId );
     glCopyBufferSubData( GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, srcIndex, 0, atom_capacity() );
 
     // 3# Copy source content back to new destination
-    glBindBuffer( GL_COPY_READ_BUFFER, tempId );
-    glBindBuffer( GL_COPY_WRITE_BUFFER, _id );
+    gl.bind_buffer( GL_COPY_READ_BUFFER, tempId );
+    gl.bind_buffer( GL_COPY_WRITE_BUFFER, _id );
     glCopyBufferSubData( GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, destIndex, length );
 
     // 4# Cleanup
     glDeleteBuffers( 1, &tempId );
-    glBindBuffer( GL_COPY_READ_BUFFER, 0 );
-    glBindBuffer( GL_COPY_WRITE_BUFFER, 0 );
+    gl.forget_buffer( tempId );
 }
 
 template<typename T, GLuint TYPE>
@@ -98,24 +101,23 @@ void GLBuffer<T, TYPE>::native_resize( GLuint oldCapacity, GLuint newCapacity )
     GLuint amountToCopy = std::min( oldCapacity, newCapacity );
 
     // 2# Copy content into temporary VBO
-    glBindBuffer( GL_COPY_READ_BUFFER, _id );
-    glBindBuffer( GL_COPY_WRITE_BUFFER, tempId );
+    GLStateCache& gl = GLStateCache::instance();
+    gl.bind_buffer( GL_COPY_READ_BUFFER, _id );
+    gl.bind_buffer( GL_COPY_WRITE_BUFFER, tempId );
     glCopyBufferSubData( GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, amountToCopy );
 
     // 3# Resize VBO
-    glBindBuffer( TYPE, _id );
-    glBufferData( TYPE, newCapacity, NULL, GL_STATIC_DRAW );
+    gl.bind_buffer( WRITE_TARGET, _id );
+    glBufferData( WRITE_TARGET, newCapacity, NULL, GL_STATIC_DRAW );
 
     // 4# Copy content back into original VBO
-    glBindBuffer( GL_COPY_READ_BUFFER, tempId );
-    glBindBuffer( GL_COPY_WRITE_BUFFER, _id );
+    gl.bind_buffer( GL_COPY_READ_BUFFER, tempId );
+    gl.bind_buffer( GL_COPY_WRITE_BUFFER, _id );
     glCopyBufferSubData( GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, amountToCopy );
 
     // 5# Cleanup
     glDeleteBuffers( 1, &tempId );
-    glBindBuffer( TYPE, 0 );
-    glBindBuffer( GL_COPY_READ_BUFFER, 0 );
-    glBindBuffer( GL_COPY_WRITE_BUFFER, 0 );
+    gl.forget_buffer( tempId );
 }
 
 template<typename T, GLuint TYPE>
@@ -123,12 +125,13 @@ void GLBuffer<T, TYPE>::native_delete()
 {
     LOGGER.log( Level::DEBUG ) << "[" << _id << "] Delete[" << _id << "]\n";
     glDeleteBuffers( 1, &_id );
+    GLStateCache::instance().forget_buffer( _id );
 }
 
 template<typename T, GLuint TYPE>
 void GLBuffer<T, TYPE>::native_unbind()
 {
-    glBindBuffer( TYPE, 0 );
+    GLStateCache::instance().bind_buffer( TYPE, 0 );
 }
 
 template<typename T, GLuint TYPE>
@@ -142,9 +145,8 @@ GLuint GLBuffer<T, TYPE>::native_allocate( GLuint initCapacity )
 {
     GLuint _id;
     glGenBuffers( 1, &_id );
-    glBindBuffer( TYPE, _id );
-    glBufferData( TYPE, initCapacity, NULL, GL_STATIC_DRAW );
-    glBindBuffer( TYPE, 0 );
+    GLStateCache::instance().bind_buffer( WRITE_TARGET, _id );
+    glBufferData( WRITE_TARGET, initCapacity, NULL, GL_STATIC_DRAW );
 
     LOGGER.log( Level::DEBUG ) << "[" << _id << "] Allocate[" << initCapacity << "]\n";
     return _id;
@@ -14,6 +14,7 @@
 #include "_global.h"
 #include "noncopyable.h"
 #include "vertexlayout.h"
+#include "logger.h"
 
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
@@ -57,29 +58,30 @@ void GLVAO<VERTEX>::native_create()
 {
     glGenVertexArrays( 1, &_id );
 
-    glBindVertexArray( _id );
+    GLStateCache::instance().bind_vertex_array( _id );
     for ( VertexComponent component : _layout.components() ) {
         glEnableVertexAttribArray( component.position );
     }
-    glBindVertexArray( 0 );
+    GLStateCache::instance().bind_vertex_array( 0 );
 }
 
 template<class VERTEX>
 void GLVAO<VERTEX>::native_delete()
 {
     glDeleteVertexArrays( 1, &_id );
+    GLStateCache::instance().forget_vertex_array( _id );
 }
 
 template<class VERTEX>
 void GLVAO<VERTEX>::native_bind()
 {
-    glBindVertexArray( _id );
+    GLStateCache::instance().bind_vertex_array( _id );
 }
 
 template<class VERTEX>
 void GLVAO<VERTEX>::native_unbind()
 {
-    glBindVertexArray( 0 );
+    GLStateCache::instance().bind_vertex_array( 0 );
 }
 
 template<typename VERTEX>
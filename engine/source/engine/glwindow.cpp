@@ -137,6 +137,13 @@ bool GLWindow::close_requested()
     return glfwWindowShouldClose(_handle) == GL_TRUE;
 }
 
+// False while hidden or minimized, nothing drawn then can be seen
+bool GLWindow::is_visible()
+{
+    return glfwGetWindowAttrib( _handle, GLFW_VISIBLE ) == GL_TRUE
+        && glfwGetWindowAttrib( _handle, GLFW_ICONIFIED ) == GL_FALSE;
+}
+
 GLFWwindow* GLWindow::get_handle() {
     return _handle;
 }
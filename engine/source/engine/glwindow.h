@@ -42,6 +42,7 @@ public:
     int32       get_renderwidth();
     int32       get_renderheight();
     bool        close_requested();
+    bool        is_visible();
     GLFWwindow* get_handle();
     void        swap_buffers();
     void        make_current();
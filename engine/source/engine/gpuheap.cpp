@@ -0,0 +1,190 @@
+#include "stdafx.h"
+#include "gpuheap.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Public                         */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+GpuHeap::GpuHeap( uint32 pageBytes ) : _fragmented( false )
+{
+    Requires( pageBytes > 0 );
+
+    add_page( pageBytes );
+}
+
+GpuHeap::~GpuHeap()
+{
+    for ( Page& page : _pages ) {
+        glDeleteBuffers( 1, &page.id );
+        GLStateCache::instance().forget_buffer( page.id );
+    }
+}
+
+GpuHeap::Handle GpuHeap::allocate( uint32 bytes )
+{
+    Requires( bytes > 0 );
+
+    bytes = (bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+
+    // 1# First fit over all pages, else grow by a new page
+    Allocation allocation;
+    if ( !try_allocate( bytes, (uint32)_pages.size(), 0, allocation ) ) {
+        add_page( bytes );
+
+        bool allocated = try_allocate( bytes, (uint32)_pages.size(), 0, allocation );
+        Ensures( allocated );
+    }
+
+    // 2# Hand out a handle, reusing freed ones
+    if ( !_freeHandles.empty() ) {
+        Handle handle = _freeHandles.back();
+        _freeHandles.pop_back();
+
+        _allocations[handle] = allocation;
+        return handle;
+    }
+
+    _allocations.push_back( allocation );
+    return (Handle)(_allocations.size() - 1);
+}
+
+void GpuHeap::free( Handle handle )
+{
+    Guard( handle != INVALID_HANDLE ) return;
+    Requires( handle < _allocations.size() && _allocations[handle].live );
+
+    Allocation& allocation = _allocations[handle];
+    _pages[allocation.page].ranges.free( allocation.range );
+    allocation.live = false;
+
+    _freeHandles.push_back( handle );
+    _fragmented = true;
+}
+
+void GpuHeap::write( Handle handle, uint32 offset, const void* data, uint32 bytes )
+{
+    Requires( handle < _allocations.size() && _allocations[handle].live );
+
+    const Allocation& allocation = _allocations[handle];
+    Requires( offset + bytes <= allocation.range.length() );
+
+    GLStateCache::instance().bind_buffer( GL_ARRAY_BUFFER, _pages[allocation.page].id );
+    glBufferSubData( GL_ARRAY_BUFFER, allocation.range.start() + offset, bytes, data );
+}
+
+GpuHeap::Slice GpuHeap::slice( Handle handle ) const
+{
+    Requires( handle < _allocations.size() && _allocations[handle].live );
+
+    const Allocation& allocation = _allocations[handle];
+    return { _pages[allocation.page].id, allocation.range.start() };
+}
+
+void GpuHeap::compact( uint32 budget )
+{
+    Guard( _fragmented ) return;
+
+    // 1# Candidates from the back, the last page should empty first
+    std::vector<Handle> order;
+    for ( Handle handle = 0; handle < _allocations.size(); ++handle )
+        if ( _allocations[handle].live ) order.push_back( handle );
+
+    std::sort( order.begin(), order.end(), [this]( Handle h0, Handle h1 ) {
+        const Allocation& a0 = _allocations[h0];
+        const Allocation& a1 = _allocations[h1];
+        return a0.page != a1.page ? a0.page > a1.page : a0.range.start() > a1.range.start();
+    } );
+
+    // 2# Move into the first hole before each, copied on the GPU
+    uint32 moved = 0;
+    bool   done  = true;
+
+    for ( Handle handle : order ) {
+        Allocation& from = _allocations[handle];
+        uint32 bytes = from.range.length();
+
+        // Out of budget, the rest moves in the next frames. The first move of a
+        // pass always goes, or an allocation above the budget could never move.
+        if ( moved > 0 && moved + bytes > budget ) {
+            done = false;
+            break;
+        }
+
+        Allocation to;
+        if ( !try_allocate( bytes, from.page, from.range.start(), to ) ) continue;
+
+        GLStateCache::instance().bind_buffer( GL_COPY_READ_BUFFER, _pages[from.page].id );
+        GLStateCache::instance().bind_buffer( GL_COPY_WRITE_BUFFER, _pages[to.page].id );
+        glCopyBufferSubData( GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, from.range.start(), to.range.start(), bytes );
+
+        _pages[from.page].ranges.free( from.range );
+        from = to;
+        moved += bytes;
+    }
+
+    // A full pass leaves nothing to move until the next free()
+    _fragmented = !done;
+    release_empty_pages();
+
+    LOGGER.log( Level::DEBUG ) << "Compacted " << moved << " bytes, " << _pages.size() << " pages left\n";
+}
+
+size_t GpuHeap::num_pages() const
+{
+    return _pages.size();
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Private                        */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+bool GpuHeap::try_allocate( uint32 bytes, uint32 lastPage, uint32 below, Allocation& allocation )
+{
+    // Pages before lastPage anywhere, lastPage itself only before below
+    for ( uint32 page = 0; page < _pages.size() && page <= lastPage; ++page ) {
+        optional<Range> range = page < lastPage ? _pages[page].ranges.allocate( bytes )
+                                                : _pages[page].ranges.allocate_below( bytes, below );
+
+        if ( range ) {
+            allocation = { page, *range, true };
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void GpuHeap::add_page( uint32 minBytes )
+{
+    uint32 bytes = _pages.empty() ? minBytes : _pages.back().ranges.capacity() * 2;
+    while ( bytes < minBytes ) bytes *= 2;
+
+    Page page = { 0, RangeAllocator( bytes ) };
+
+    glGenBuffers( 1, &page.id );
+    GLStateCache::instance().bind_buffer( GL_ARRAY_BUFFER, page.id );
+    glBufferData( GL_ARRAY_BUFFER, bytes, nullptr, GL_STATIC_DRAW );
+
+    LOGGER.log( Level::INFO ) << "Add page [" << page.id << "] of " << bytes << " bytes\n";
+    _pages.push_back( page );
+}
+
+void GpuHeap::release_empty_pages()
+{
+    // Only from the back, allocations refer to pages by index. The first page always stays.
+    while ( _pages.size() > 1 && _pages.back().ranges.empty() ) {
+        glDeleteBuffers( 1, &_pages.back().id );
+        GLStateCache::instance().forget_buffer( _pages.back().id );
+        _pages.pop_back();
+    }
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                      Private Static                    */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+Logger GpuHeap::LOGGER = Logger( "GpuHeap", Level::WARN );
+
+ENGINE_NAMESPACE_END
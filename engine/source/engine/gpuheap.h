@@ -0,0 +1,96 @@
+#pragma once
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                        Includes                        */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+// Std-Includes
+#include <vector>
+
+// Other Includes
+
+// Internal Includes
+#include "_gl.h"
+#include "_global.h"
+#include "noncopyable.h"
+#include "logger.h"
+
+#include "range.h"
+#include "rangeallocator.h"
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Class                          */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+ENGINE_NAMESPACE_BEGIN
+
+// Long-lived vertex data of many renderers, sub-allocated from a few
+// large GL buffers ( pages ).
+//
+// A renderer owns a Handle instead of a VBO. Pages never resize, when
+// none has room the heap adds one twice as large as the last, so growing
+// never copies. compact() runs once per frame and moves a bounded amount
+// of allocations into holes nearer the front, GPU side, until the last
+// pages run empty and are released. Allocations can move, so renderers
+// look up their slice() every time they point attributes at it.
+//
+//    GpuHeap::Handle tiles = heap.allocate( bytes );
+//    heap.write( tiles, 0, data, bytes );
+//    GpuHeap::Slice slice = heap.slice( tiles );  // per draw
+//    heap.free( tiles );
+class GpuHeap : public noncopyable
+{
+public:
+    typedef uint32 Handle;
+
+    struct Slice {
+        GLuint buffer;
+        uint32 offset;
+    };
+
+    static const Handle INVALID_HANDLE = 0xFFFFFFFF;
+    static const uint32 DEFAULT_PAGE_BYTES = 1024 * 1024;
+    static const uint32 ALIGNMENT = 16;
+
+            explicit GpuHeap( uint32 pageBytes = DEFAULT_PAGE_BYTES );
+            ~GpuHeap();
+
+    Handle  allocate( uint32 bytes );
+    void    free( Handle handle );
+
+    // Writes bytes at offset into the allocation
+    void    write( Handle handle, uint32 offset, const void* data, uint32 bytes );
+    Slice   slice( Handle handle ) const;
+
+    // Moves up to budget bytes of allocations forward, at least one allocation
+    // however large, and releases empty last pages
+    void    compact( uint32 budget );
+
+    size_t  num_pages() const;
+
+private:
+    struct Page {
+        GLuint          id;
+        RangeAllocator  ranges;
+    };
+
+    struct Allocation {
+        uint32  page;
+        Range   range;
+        bool    live;
+    };
+
+    bool    try_allocate( uint32 bytes, uint32 lastPage, uint32 below, Allocation& allocation );
+    void    add_page( uint32 minBytes );
+    void    release_empty_pages();
+
+    std::vector<Page>       _pages;
+    std::vector<Allocation> _allocations;
+    std::vector<Handle>     _freeHandles;
+
+    // Set by free(), cleared once a compaction pass finds nothing to move
+    bool                    _fragmented;
+
+    static Logger LOGGER;
+};
+
+ENGINE_NAMESPACE_END
@@ -0,0 +1,241 @@
+#include "stdafx.h"
+#include "jobsystem.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                        JobCounter                      */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+JobCounter::JobCounter()
+    : _pending( 0 )
+{
+}
+
+bool JobCounter::is_done() const
+{
+    return _pending == 0;
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                      Public Static                     */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+thread_local uint32 JobSystem::WORKER_INDEX = ~uint32( 0 );
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Public                         */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+JobSystem::JobSystem( uint32 numWorkers )
+    : _numQueued( 0 ), _running( true )
+{
+    if ( numWorkers == 0 ) {
+        uint32 hardware = std::thread::hardware_concurrency();
+        numWorkers = hardware > 1 ? hardware - 1 : 1;
+    }
+
+    // Create all deques before the first worker can try to steal from them
+    for ( uint32 i = 0; i < numWorkers; ++i )
+        _workers.push_back( make_unique<Worker>() );
+
+    for ( uint32 i = 0; i < numWorkers; ++i )
+        _workers[i]->thread = std::thread( &JobSystem::worker_main, this, i );
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock( _sleepMutex );
+        _running = false;
+    }
+    _sleepCondition.notify_all();
+
+    for ( auto& worker : _workers )
+        worker->thread.join();
+
+    // Jobs nobody ran anymore
+    Job* job;
+    for ( auto& worker : _workers )
+        while ( worker->jobs.pop( job ) )
+            delete job;
+
+    for ( Job* job : _injected ) delete job;
+    for ( Job* job : _mainJobs ) delete job;
+}
+
+void JobSystem::submit( task_t task, JobCounter* counter )
+{
+    if ( counter != nullptr )
+        counter->_pending++;
+
+    enqueue( new Job{ std::move( task ), counter } );
+}
+
+void JobSystem::submit_after( JobCounter& dependency, task_t task, JobCounter* counter )
+{
+    if ( counter != nullptr )
+        counter->_pending++;
+
+    {
+        // finish() drains the continuations under the same lock after the counter hit zero
+        std::lock_guard<std::mutex> lock( dependency._mutex );
+
+        if ( dependency._pending > 0 ) {
+            dependency._continuations.push_back( [this, task = std::move( task ), counter]() mutable {
+                enqueue( new Job{ std::move( task ), counter } );
+            } );
+            return;
+        }
+    }
+
+    enqueue( new Job{ std::move( task ), counter } );
+}
+
+void JobSystem::wait( const atomic<uint32>& counter )
+{
+    while ( counter > 0 ) {
+        Guard( try_run_one( WORKER_INDEX ) ) std::this_thread::yield();
+    }
+}
+
+void JobSystem::wait( const JobCounter& counter )
+{
+    wait( counter._pending );
+
+    // The last finish() may still hold the lock, the counter must outlive it
+    std::lock_guard<std::mutex> lock( counter._mutex );
+}
+
+void JobSystem::submit_main( task_t task, JobCounter* counter )
+{
+    if ( counter != nullptr )
+        counter->_pending++;
+
+    std::lock_guard<std::mutex> lock( _mainMutex );
+    _mainJobs.push_back( new Job{ std::move( task ), counter } );
+}
+
+void JobSystem::run_main_jobs()
+{
+    std::vector<Job*> jobs;
+
+    {
+        std::lock_guard<std::mutex> lock( _mainMutex );
+        jobs.swap( _mainJobs );
+    }
+
+    for ( Job* job : jobs )
+        execute( job );
+}
+
+uint32 JobSystem::num_workers() const
+{
+    return (uint32)_workers.size();
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Private                        */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+void JobSystem::worker_main( uint32 index )
+{
+    WORKER_INDEX = index;
+
+    while ( true ) {
+        if ( try_run_one( index ) )
+            continue;
+
+        std::unique_lock<std::mutex> lock( _sleepMutex );
+        _sleepCondition.wait( lock, [this]() { return _numQueued > 0 || !_running; } );
+
+        Guard( _running ) return;
+    }
+}
+
+void JobSystem::enqueue( Job* job )
+{
+    if ( WORKER_INDEX < _workers.size() ) {
+        _workers[WORKER_INDEX]->jobs.push( job );
+    }
+    else {
+        std::lock_guard<std::mutex> lock( _injectedMutex );
+        _injected.push_back( job );
+    }
+
+    {
+        std::lock_guard<std::mutex> lock( _sleepMutex );
+        _numQueued++;
+    }
+    _sleepCondition.notify_one();
+}
+
+bool JobSystem::steal( uint32 thief, Job*& job )
+{
+    // 1# Jobs from outside the pool
+    {
+        std::lock_guard<std::mutex> lock( _injectedMutex );
+
+        if ( !_injected.empty() ) {
+            job = _injected.front();
+            _injected.pop_front();
+            return true;
+        }
+    }
+
+    // 2# Other workers, starting next to the thief so victims are spread
+    uint32 numWorkers = (uint32)_workers.size();
+    uint32 start      = thief < numWorkers ? thief + 1 : 0;
+
+    for ( uint32 i = 0; i < numWorkers; ++i ) {
+        uint32 victim = (start + i) % numWorkers;
+        if ( victim != thief && _workers[victim]->jobs.steal( job ) )
+            return true;
+    }
+
+    return false;
+}
+
+bool JobSystem::try_run_one( uint32 index )
+{
+    Job* job = nullptr;
+
+    bool found = (index < _workers.size() && _workers[index]->jobs.pop( job )) || steal( index, job );
+    Guard( found ) return false;
+
+    _numQueued--;
+    execute( job );
+    return true;
+}
+
+void JobSystem::execute( Job* job )
+{
+    job->task();
+
+    if ( job->counter != nullptr )
+        finish( *job->counter );
+
+    delete job;
+}
+
+void JobSystem::finish( JobCounter& counter )
+{
+    std::vector<function<void()>> continuations;
+
+    {
+        // Decrement under the lock, a waiter may destroy the counter as soon as it is released
+        std::lock_guard<std::mutex> lock( counter._mutex );
+
+        if ( --counter._pending == 0 )
+            continuations.swap( counter._continuations );
+    }
+
+    for ( auto& continuation : continuations )
+        continuation();
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                      Private Static                    */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+ENGINE_NAMESPACE_END
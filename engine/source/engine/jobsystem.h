@@ -0,0 +1,176 @@
+#pragma once
+
+// Std-Includes
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+// Other Includes
+
+// Internal Includes
+#include "_global.h"
+#include "workstealingdeque.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+// Number of outstanding jobs. Jobs submitted with submit_after() are held
+// back until the counter drops to zero. A counter may be reused, or
+// destroyed, once JobSystem::wait() on it has returned.
+class JobCounter : public noncopyable
+{
+public:
+            JobCounter();
+
+    bool    is_done() const;
+
+private:
+    friend class JobSystem;
+
+    atomic<uint32>                  _pending;
+
+    mutable std::mutex              _mutex;
+    std::vector<function<void()>>   _continuations;
+};
+
+// The engine's worker threads, one Chase-Lev deque per worker.
+//
+// Workers pop their own deque from the bottom (LIFO, cache-warm) and steal
+// from the top of the others (FIFO, oldest = largest work first) when
+// their own runs dry. Jobs submitted from a worker go to that worker's
+// deque, jobs from other threads go through a shared injection queue.
+//
+// Waiting threads help out instead of blocking:
+//
+//    JobCounter counter;
+//    for ( ... ) jobs.submit( [&]() { ... }, &counter );
+//    jobs.wait( counter );
+//
+// GL calls have to stay on the thread that owns the context. They go into
+// the main queue, which only that thread drains with run_main_jobs().
+class JobSystem : public noncopyable
+{
+public:
+    typedef function<void()> task_t;
+
+    static const size_t DEFAULT_GRAIN_SIZE = 1024;
+
+    // numWorkers = 0 picks hardware_concurrency() - 1, the caller is the last thread
+            explicit JobSystem( uint32 numWorkers = 0 );
+            ~JobSystem();
+
+    void    submit( task_t task, JobCounter* counter = nullptr );
+
+    // Submits task once dependency is done, right away if it already is
+    void    submit_after( JobCounter& dependency, task_t task, JobCounter* counter = nullptr );
+
+    // Executes pending jobs on the calling thread until counter reaches zero
+    void    wait( const atomic<uint32>& counter );
+    void    wait( const JobCounter& counter );
+
+    // Calls func( begin, end ) on disjoint ranges of at most grainSize and returns when all are done
+    template<typename FUNC>
+    void    parallel_for( size_t begin, size_t end, size_t grainSize, FUNC&& func );
+
+    // Sorts runs of grainSize in parallel, then merges them pairwise. Not stable.
+    template<typename IT, typename LESS>
+    void    parallel_sort( IT first, IT last, LESS less, size_t grainSize = DEFAULT_GRAIN_SIZE );
+
+    // Main queue, run_main_jobs() is only ever called by the GL thread
+    void    submit_main( task_t task, JobCounter* counter = nullptr );
+    void    run_main_jobs();
+
+    uint32  num_workers() const;
+
+private:
+    struct Job {
+        task_t      task;
+        JobCounter* counter;
+    };
+
+    struct Worker {
+        WorkStealingDeque<Job*> jobs;
+        std::thread             thread;
+    };
+
+    void    worker_main( uint32 index );
+    void    enqueue( Job* job );
+    bool    steal( uint32 thief, Job*& job );
+    bool    try_run_one( uint32 index );
+    void    execute( Job* job );
+    void    finish( JobCounter& counter );
+
+    std::vector<unique<Worker>> _workers;
+
+    std::mutex                  _injectedMutex;
+    std::deque<Job*>            _injected;
+
+    std::mutex                  _mainMutex;
+    std::vector<Job*>           _mainJobs;
+
+    atomic<uint32>              _numQueued;
+    atomic<bool>                _running;
+
+    std::mutex                  _sleepMutex;
+    std::condition_variable     _sleepCondition;
+
+    // Index of the worker deque owned by the current thread, ~0 for foreign threads
+    static thread_local uint32  WORKER_INDEX;
+};
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                   Template Definitions                 */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+template<typename FUNC>
+void JobSystem::parallel_for( size_t begin, size_t end, size_t grainSize, FUNC&& func )
+{
+    Guard( begin < end ) return;
+    grainSize = std::max<size_t>( grainSize, 1 );
+
+    JobCounter counter;
+    for ( size_t first = begin; first < end; first += grainSize ) {
+        size_t last = std::min( first + grainSize, end );
+        submit( [&func, first, last]() { func( first, last ); }, &counter );
+    }
+
+    wait( counter );
+}
+
+template<typename IT, typename LESS>
+void JobSystem::parallel_sort( IT first, IT last, LESS less, size_t grainSize )
+{
+    size_t size = (size_t)(last - first);
+    grainSize = std::max<size_t>( grainSize, 1 );
+
+    if ( size <= grainSize ) {
+        std::sort( first, last, less );
+        return;
+    }
+
+    // 1# Sort runs
+    size_t numRuns = (size + grainSize - 1) / grainSize;
+    parallel_for( 0, numRuns, 1, [&]( size_t begin, size_t end ) {
+        for ( size_t run = begin; run < end; ++run )
+            std::sort( first + run * grainSize, first + std::min( (run + 1) * grainSize, size ), less );
+    } );
+
+    // 2# Merge neighbouring runs, doubling the run width each round
+    for ( size_t width = grainSize; width < size; width *= 2 ) {
+        size_t numMerges = (size + 2 * width - 1) / (2 * width);
+
+        parallel_for( 0, numMerges, 1, [&]( size_t begin, size_t end ) {
+            for ( size_t merge = begin; merge < end; ++merge ) {
+                size_t lo  = merge * 2 * width;
+                size_t mid = std::min( lo + width, size );
+                size_t hi  = std::min( lo + 2 * width, size );
+
+                if ( mid < hi )
+                    std::inplace_merge( first + lo, first + mid, first + hi, less );
+            }
+        } );
+    }
+}
+
+ENGINE_NAMESPACE_END
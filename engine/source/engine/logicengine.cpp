@@ -6,6 +6,30 @@ ENGINE_NAMESPACE_BEGIN
 /*                         Public                         */
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
+LogicEngine::LogicEngine( weak<JobSystem> jobs, bool hasRenderer )
+    : _hasRenderer( hasRenderer )
+{
+    _scheduler = make_owner<SystemScheduler>( jobs );
+
+    add_system( System( "controllable", CControllable::get_priority() )
+        .reads<CControllable>()
+        .writes<CTransform>()
+        .each<CControllable, CTransform>( []( float delta, Entity, CControllable& ctrl, CTransform& transform ) {
+            ctrl.update( delta, transform );
+        } ) );
+
+    add_system( System( "tilemap", CTilemapLogic::get_priority() )
+        .writes<CTilemapLogic>()
+        .each<CTilemapLogic>( []( float delta, Entity, CTilemapLogic& tilemap ) {
+            tilemap.update( delta );
+        } ) );
+}
+
+void LogicEngine::add_system( System system )
+{
+    _scheduler->add( std::move( system ) );
+}
+
 void LogicEngine::on_start()
 {
 
@@ -13,27 +37,28 @@ void LogicEngine::on_start()
 
 void LogicEngine::on_tick_start()
 {
-    //_snapshot.clear();
-    //for ( auto entity : _entities ) {
-    //    unique<Entity>  copy = make_unique<Entity>();
-
-    //    //entitySys.create_snapshot_full( *copy, *entity );
-    //    //controllableSys.create_snapshot_full( *copy, *entity );
+    Component::advance_tick();
 
-    //    _snapshot.emplace_back( std::move( copy ) );
-    //}
+    // Last tick's transforms become the interpolation source for rendering
+    CTransform::get_buffer().flip();
 }
 
 void LogicEngine::on_update( float delta )
 {
-  for ( auto& c : CTransform::get_all_components().values() )
-    c.update(delta);
+    _scheduler->run( delta );
+}
+
+void LogicEngine::on_tick_end()
+{
+    // Gamestate and systems are done with this tick, structural changes can go in now
+    CommandBuffer::playback_all();
+    Entity::flush_destroyed();
 
-  for ( auto& c : CControllable::get_all_components().values() )
-    c.update( delta );
+    // Hand the finished tick over to the render thread, if there is one
+    Guard( _hasRenderer ) return;
 
-  for ( auto& c : CTilemapLogic::get_all_components().values() )
-    c.update( delta );
+    _snapshots.write().capture( Component::current_tick(), FramePacer::now_ns() );
+    _snapshots.publish();
 }
 
 void LogicEngine::on_shutdown()
@@ -46,6 +71,11 @@ void LogicEngine::on_gamestate_end()
 
 }
 
+const RenderSnapshot& LogicEngine::acquire_snapshot()
+{
+    return _snapshots.acquire();
+}
+
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 /*                         Private                        */
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
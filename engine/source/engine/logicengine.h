@@ -13,19 +13,42 @@
 #include "transform.h"
 #include "controllable.h"
 #include "component.h"
+#include "view.h"
 #include "tilemaplogic.h"
+#include "jobsystem.h"
+#include "systemscheduler.h"
+#include "commandbuffer.h"
+#include "triplebuffer.h"
+#include "framepacer.h"
+#include "rendersnapshot.h"
 
 ENGINE_NAMESPACE_BEGIN
 
 class LogicEngine
 {
 public:
+    // Without a renderer no RenderSnapshot is captured, e.g. when headless
+    LogicEngine( weak<JobSystem> jobs, bool hasRenderer );
+
+    // Registers a system that runs every tick, see SystemScheduler for the ordering rules
+    void add_system( System system );
+
     void on_start();
     void on_tick_start();
     void on_update(float delta);
+    void on_tick_end();
     void on_shutdown();
 
     void on_gamestate_end();
+
+    // Latest snapshot published by on_tick_end(), render thread only
+    const RenderSnapshot& acquire_snapshot();
+
+private:
+    owner<SystemScheduler>  _scheduler;
+    bool                    _hasRenderer;
+
+    TripleBuffer<RenderSnapshot> _snapshots;
 };
 
 ENGINE_NAMESPACE_END
@@ -0,0 +1,167 @@
+#include "stdafx.h"
+#include "loosegrid.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Public                         */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+LooseGrid::LooseGrid( float cellSize ) : _cellSize( cellSize ), _size( 0 )
+{
+    Requires( cellSize > 0 );
+}
+
+void LooseGrid::update( uint32 id, const Rect4f& bounds )
+{
+    if ( id >= _items.size() )
+        _items.resize( id + 1, Item{ 0, 0, 0, 0, 0, 0, false } );
+
+    Item& item = _items[id];
+    int64 cell = cell_of( bounds );
+
+    // Only relinked when the center changed cells
+    bool moved = !item.live || item.cell != cell;
+
+    if ( item.live && moved )
+        unlink( item );
+
+    if ( moved ) {
+        std::vector<uint32>& list = list_of( cell );
+        item.cell = cell;
+        item.slot = (uint32)list.size();
+        list.push_back( id );
+    }
+
+    if ( !item.live ) {
+        item.live = true;
+        ++_size;
+    }
+
+    item.minX = bounds.min_x();
+    item.minY = bounds.min_y();
+    item.maxX = bounds.max_x();
+    item.maxY = bounds.max_y();
+}
+
+void LooseGrid::remove( uint32 id )
+{
+    Guard( contains( id ) ) return;
+
+    Item& item = _items[id];
+    unlink( item );
+    item.live = false;
+    --_size;
+}
+
+void LooseGrid::clear()
+{
+    _items.clear();
+    _cells.clear();
+    _large.clear();
+    _size = 0;
+}
+
+bool LooseGrid::contains( uint32 id ) const
+{
+    return id < _items.size() && _items[id].live;
+}
+
+void LooseGrid::query( const Rect4f& area, std::vector<uint32>& ids ) const
+{
+    check( _large, area, ids );
+
+    // Items reach up to half a cell out of their cell
+    float half = _cellSize / 2;
+    int32 x0 = cell_coord( area.min_x() - half );
+    int32 x1 = cell_coord( area.max_x() + half );
+    int32 y0 = cell_coord( area.min_y() - half );
+    int32 y1 = cell_coord( area.max_y() + half );
+
+    // An area wider than the populated part of the grid walks the cells that exist instead
+    uint64 numCells = (uint64)((int64)x1 - x0 + 1) * (uint64)((int64)y1 - y0 + 1);
+    if ( numCells > _cells.size() ) {
+        for ( auto& cell : _cells )
+            check( cell.second, area, ids );
+        return;
+    }
+
+    for ( int32 y = y0; y <= y1; ++y )
+        for ( int32 x = x0; x <= x1; ++x ) {
+            auto cell = _cells.find( cell_key( x, y ) );
+            if ( cell != _cells.end() )
+                check( cell->second, area, ids );
+        }
+}
+
+size_t LooseGrid::size() const
+{
+    return _size;
+}
+
+size_t LooseGrid::num_cells() const
+{
+    return _cells.size();
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Private                        */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+int64 LooseGrid::cell_of( const Rect4f& bounds ) const
+{
+    // Wouldn't stay within half a cell of its cell
+    if ( bounds.width() > _cellSize || bounds.height() > _cellSize )
+        return LARGE;
+
+    return cell_key( cell_coord( bounds.min_x() + bounds.width() / 2 ),
+                     cell_coord( bounds.min_y() + bounds.height() / 2 ) );
+}
+
+int32 LooseGrid::cell_coord( float v ) const
+{
+    // Clamped, so far away bounds share the outermost cells instead of overflowing
+    float coord = std::floor( v / _cellSize );
+    return (int32)std::min( std::max( coord, -1e9f ), 1e9f );
+}
+
+std::vector<uint32>& LooseGrid::list_of( int64 cell )
+{
+    return cell == LARGE ? _large : _cells[cell];
+}
+
+void LooseGrid::unlink( Item& item )
+{
+    std::vector<uint32>& list = list_of( item.cell );
+
+    // Swap with the last, the moved item takes over the slot
+    uint32 last = list.back();
+    list[item.slot] = last;
+    _items[last].slot = item.slot;
+    list.pop_back();
+
+    if ( list.empty() && item.cell != LARGE )
+        _cells.erase( item.cell );
+}
+
+void LooseGrid::check( const std::vector<uint32>& ids, const Rect4f& area, std::vector<uint32>& out ) const
+{
+    for ( uint32 id : ids ) {
+        const Item& item = _items[id];
+
+        if ( item.minX <= area.max_x() && area.min_x() <= item.maxX
+          && item.minY <= area.max_y() && area.min_y() <= item.maxY )
+            out.push_back( id );
+    }
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                      Private Static                    */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+int64 LooseGrid::cell_key( int32 x, int32 y )
+{
+    return (int64)((uint64)(uint32)x << 32 | (uint32)y);
+}
+
+ENGINE_NAMESPACE_END
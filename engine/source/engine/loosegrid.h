@@ -0,0 +1,78 @@
+#pragma once
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                        Includes                        */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+// Std-Includes
+#include <vector>
+#include <unordered_map>
+
+// Other Includes
+
+// Internal Includes
+#include "_global.h"
+#include "noncopyable.h"
+#include "rect4f.h"
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Class                          */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+ENGINE_NAMESPACE_BEGIN
+
+// Spatial index over 2D bounds, for finding what overlaps an area.
+//
+// Every item lives in exactly one cell, the one its center falls into.
+// Cells are loose: an item may reach half a cell past its cell's edges,
+// so moving it only touches the grid when its center changes cells.
+// Items bigger than a cell go into a list that every query checks.
+// Only cells that hold items exist, queries look up the cells around the
+// area, so they cost what's near the area and not what's in the grid.
+//
+//    grid.update( id, bounds );      // insert or move
+//    grid.query( area, ids );        // appends ids overlapping area
+class LooseGrid : public noncopyable
+{
+public:
+            explicit LooseGrid( float cellSize );
+            ~LooseGrid() = default;
+
+    void    update( uint32 id, const Rect4f& bounds );
+    void    remove( uint32 id );
+    void    clear();
+
+    bool    contains( uint32 id ) const;
+
+    // Appends, in no particular order
+    void    query( const Rect4f& area, std::vector<uint32>& ids ) const;
+
+    size_t  size() const;
+    size_t  num_cells() const;
+
+private:
+    static const int64  LARGE = INT64_MAX;
+
+    struct Item {
+        float   minX, minY, maxX, maxY;
+        int64   cell;
+        uint32  slot;       // Index in its cell's list
+        bool    live;
+    };
+
+    float                                       _cellSize;
+    size_t                                      _size;
+
+    std::vector<Item>                           _items;     // By id
+    std::unordered_map<int64, std::vector<uint32>> _cells;
+    std::vector<uint32>                         _large;
+
+    int64                   cell_of( const Rect4f& bounds ) const;
+    int32                   cell_coord( float v ) const;
+    std::vector<uint32>&    list_of( int64 cell );
+    void                    unlink( Item& item );
+    void                    check( const std::vector<uint32>& ids, const Rect4f& area, std::vector<uint32>& out ) const;
+
+    static int64            cell_key( int32 x, int32 y );
+};
+
+ENGINE_NAMESPACE_END
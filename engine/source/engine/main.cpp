@@ -19,6 +19,6 @@ int main(int argc, char *argv[])
         _CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
     #endif
 
-   Engine engine;
+   Engine engine( EngineConfig::from_args( argc, argv ) );
    return engine.run();
 }
@@ -7,9 +7,26 @@ ENGINE_NAMESPACE_BEGIN
 /*                         Public                         */
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
+Material::Material() : _worldHandle( Uniform::INVALID_HANDLE ), _depthHandle( Uniform::INVALID_HANDLE ), _diffuseUnit( -1 )
+{
+}
+
 void Material::set_shader( weak<Shader> shader )
 {
-    _shader = shader;
+    _shader      = shader;
+    _worldHandle = Uniform::INVALID_HANDLE;
+    _depthHandle = Uniform::INVALID_HANDLE;
+    _diffuseUnit = -1;
+
+    Guard( _shader ) return;
+
+    _worldHandle = _shader->uniform_handle( Uniform::WORLD_MATRIX );
+    _depthHandle = _shader->uniform_handle( Uniform::WORLD_DEPTH );
+
+    nullable<TextureSlot> diffuse = _shader->frag_texture_slot( TextureSlot::TEXTURE_DIFFUSE.name );
+    if ( !diffuse.is_null() ) {
+        _diffuseUnit = diffuse.get().glTextureSlot;
+    }
 }
 
 weak<Shader> Material::get_shader() const
@@ -14,25 +14,33 @@ ENGINE_NAMESPACE_BEGIN
 class Material
 {
 public:
+                    Material();
+
     void            set_shader( weak<Shader> shader );
     weak<Shader>    get_shader() const;
 
     void            set_texture_diffuse( weak<Texture> texture );
     weak<Texture>   get_texture_diffuse() const;
 
-    HOTPATH void    set_wvp( Matrix4f wvp );
+    HOTPATH void    set_world( const Affine2D& world, float depth );
     HOTPATH void    bind() const;
 
 private:
     weak<Shader>  _shader;
     weak<Texture> _textureDiffuse;
 
+    // Resolved in set_shader(), so binding and drawing need no lookups
+    Uniform::Handle _worldHandle;
+    Uniform::Handle _depthHandle;
+    int32           _diffuseUnit;
+
 };
 
-inline void Material::set_wvp( Matrix4f wvp )
+inline void Material::set_world( const Affine2D& world, float depth )
 {
     if ( _shader ) {
-        _shader->set_vertex_uniform( Uniform::WORLD_VIEW_PROJ_MATRIX, wvp );
+        _shader->set_uniform( _worldHandle, world );
+        _shader->set_uniform( _depthHandle, depth );
     }
 }
 
@@ -40,11 +48,8 @@ inline void Material::bind() const {
     if ( _shader ) {
         _shader->bind();
 
-        if ( _textureDiffuse ) {
-            TextureSlot slot0 = _shader->frag_texture_slot( TextureSlot::TEXTURE_DIFFUSE.name ).get();
-            glUniform1i( slot0.location, slot0.slot );
-            glActiveTexture( slot0.glTextureSlot );
-            glBindTexture( GL_TEXTURE_2D, _textureDiffuse->id() );
+        if ( _textureDiffuse && _diffuseUnit >= 0 ) {
+            GLStateCache::instance().bind_texture( _diffuseUnit, _textureDiffuse->id() );
         }
     }
 }
@@ -174,205 +174,154 @@ Matrix4f::Matrix4f() : m00(0), m01(0), m02(0), m03(0),
 {
 }
 
-Matrix4f::Matrix4f(Matrix4f& copy)
+bool Matrix4f::operator==(const Matrix4f& o) const
 {
-    m00 = copy.m00;
-    m01 = copy.m01;
-    m02 = copy.m02;
-    m03 = copy.m03;
-
-    m10 = copy.m10;
-    m11 = copy.m11;
-    m12 = copy.m12;
-    m13 = copy.m13;
-
-    m20 = copy.m20;
-    m21 = copy.m21;
-    m22 = copy.m22;
-    m23 = copy.m23;
-
-    m30 = copy.m30;
-    m31 = copy.m31;
-    m32 = copy.m32;
-    m33 = copy.m33;
+    __m128 eq = _mm_and_ps( _mm_and_ps( _mm_cmpeq_ps( row( 0 ), o.row( 0 ) ), _mm_cmpeq_ps( row( 1 ), o.row( 1 ) ) ),
+                            _mm_and_ps( _mm_cmpeq_ps( row( 2 ), o.row( 2 ) ), _mm_cmpeq_ps( row( 3 ), o.row( 3 ) ) ) );
+    return _mm_movemask_ps( eq ) == 0xF;
 }
 
-bool Matrix4f::operator==(Matrix4f& o) const
-{
-    return m00 == o.m00 && m01 == o.m01 && m02 == o.m02 && m03 == o.m03
-        && m10 == o.m10 && m11 == o.m11 && m12 == o.m12 && m13 == o.m13
-        && m20 == o.m20 && m21 == o.m21 && m22 == o.m22 && m23 == o.m23
-        && m30 == o.m30 && m31 == o.m31 && m32 == o.m32 && m33 == o.m33;
-}
-
-bool Matrix4f::operator!=(Matrix4f& o) const
+bool Matrix4f::operator!=(const Matrix4f& o) const
 {
     return !(*this == o);
 }
 
 Matrix4f Matrix4f::operator!() const
 {
-    double b0 = (m20 * m31) - (m21 * m30);
-    double b1 = (m20 * m32) - (m22 * m30);
-    double b2 = (m23 * m30) - (m21 * m33);
-    double b3 = (m21 * m32) - (m22 * m31);
-    double b4 = (m23 * m31) - (m21 * m33);
-    double b5 = (m22 * m33) - (m23 * m32);
-
-    double d11 = m11 *  b5 + m12 *  b4 + m13 * b3;
-    double d12 = m10 *  b5 + m12 *  b2 + m13 * b1;
-    double d13 = m10 * -b4 + m11 *  b2 + m13 * b0;
-    double d14 = m10 *  b3 + m11 * -b1 + m12 * b0;
-
-    double det = m00 * d11 - m01 * d12 + m02 * d13 - m03 * d14;
-    if (abs(det) == 0.0) {
+    // Block inverse over the 2x2 sub-matrices | A B |
+    //                                         | C D |, each held in one register.
+    // Inverse and transpose commute, so the field order doesn't matter here.
+    __m128 r0 = row( 0 ), r1 = row( 1 ), r2 = row( 2 ), r3 = row( 3 );
+
+    __m128 A = _mm_movelh_ps( r0, r1 );
+    __m128 B = _mm_movehl_ps( r1, r0 );
+    __m128 C = _mm_movelh_ps( r2, r3 );
+    __m128 D = _mm_movehl_ps( r3, r2 );
+
+    // ( |A|, |B|, |C|, |D| )
+    __m128 detSub = _mm_sub_ps( _mm_mul_ps( SIMD_SHUFFLE( r0, r2, 0, 2, 0, 2 ), SIMD_SHUFFLE( r1, r3, 1, 3, 1, 3 ) ),
+                                _mm_mul_ps( SIMD_SHUFFLE( r0, r2, 1, 3, 1, 3 ), SIMD_SHUFFLE( r1, r3, 0, 2, 0, 2 ) ) );
+    __m128 detA = SIMD_SPLAT( detSub, 0 );
+    __m128 detB = SIMD_SPLAT( detSub, 1 );
+    __m128 detC = SIMD_SPLAT( detSub, 2 );
+    __m128 detD = SIMD_SPLAT( detSub, 3 );
+
+    // 2x2 products, X# is the adjugate of X
+    auto mul    = []( __m128 a, __m128 b ) {   // a * b
+        return _mm_add_ps( _mm_mul_ps( a, SIMD_SWIZZLE( b, 0, 3, 0, 3 ) ),
+                           _mm_mul_ps( SIMD_SWIZZLE( a, 1, 0, 3, 2 ), SIMD_SWIZZLE( b, 2, 1, 2, 1 ) ) );
+    };
+    auto adjMul = []( __m128 a, __m128 b ) {   // a# * b
+        return _mm_sub_ps( _mm_mul_ps( SIMD_SWIZZLE( a, 3, 3, 0, 0 ), b ),
+                           _mm_mul_ps( SIMD_SWIZZLE( a, 1, 1, 2, 2 ), SIMD_SWIZZLE( b, 2, 3, 0, 1 ) ) );
+    };
+    auto mulAdj = []( __m128 a, __m128 b ) {   // a * b#
+        return _mm_sub_ps( _mm_mul_ps( a, SIMD_SWIZZLE( b, 3, 0, 3, 0 ) ),
+                           _mm_mul_ps( SIMD_SWIZZLE( a, 1, 0, 3, 2 ), SIMD_SWIZZLE( b, 2, 1, 2, 1 ) ) );
+    };
+
+    __m128 DC = adjMul( D, C );
+    __m128 AB = adjMul( A, B );
+
+    __m128 X = _mm_sub_ps( _mm_mul_ps( detD, A ), mul( B, DC ) );
+    __m128 W = _mm_sub_ps( _mm_mul_ps( detA, D ), mul( C, AB ) );
+    __m128 Y = _mm_sub_ps( _mm_mul_ps( detB, C ), mulAdj( D, AB ) );
+    __m128 Z = _mm_sub_ps( _mm_mul_ps( detC, B ), mulAdj( A, DC ) );
+
+    // |M| = |A||D| + |B||C| - tr( A#B * D#C )
+    __m128 det = _mm_add_ps( _mm_mul_ps( detA, detD ), _mm_mul_ps( detB, detC ) );
+    det = _mm_sub_ps( det, simd::sum4( _mm_mul_ps( AB, SIMD_SWIZZLE( DC, 0, 2, 1, 3 ) ) ) );
+
+    if ( _mm_cvtss_f32( det ) == 0.0f ) {
         return ZERO;
     }
 
-    det = 1.0 / det;
-
-    double a0 = (m00 * m11) - (m01 * m10);
-    double a1 = (m00 * m12) - (m02 * m10);
-    double a2 = (m03 * m10) - (m00 * m13);
-    double a3 = (m01 * m12) - (m02 * m11);
-    double a4 = (m03 * m11) - (m01 * m13);
-    double a5 = (m02 * m13) - (m03 * m12);
-
-    double d21 = m01 *  b5 + m02 *  b4 + m03 * b3;
-    double d22 = m00 *  b5 + m02 *  b2 + m03 * b1;
-    double d23 = m00 * -b4 + m01 *  b2 + m03 * b0;
-    double d24 = m00 *  b3 + m01 * -b1 + m02 * b0;
-
-    double d31 = m31 *  a5 + m32 *  a4 + m33 * a3;
-    double d32 = m30 *  a5 + m32 *  a2 + m33 * a1;
-    double d33 = m30 * -a4 + m31 *  a2 + m33 * a0;
-    double d34 = m30 *  a3 + m31 * -a1 + m32 * a0;
-
-    double d41 = m21 *  a5 + m22 *  a4 + m23 * a3;
-    double d42 = m20 *  a5 + m22 *  a2 + m23 * a1;
-    double d43 = m20 * -a4 + m21 *  a2 + m23 * a0;
-    double d44 = m20 *  a3 + m21 * -a1 + m22 * a0;
+    __m128 invDet = _mm_div_ps( _mm_setr_ps( 1.0f, -1.0f, -1.0f, 1.0f ), det );
+    X = _mm_mul_ps( X, invDet );
+    Y = _mm_mul_ps( Y, invDet );
+    Z = _mm_mul_ps( Z, invDet );
+    W = _mm_mul_ps( W, invDet );
 
     Matrix4f result;
-
-    result.m00 = (float)(+d11 * det);
-    result.m10 = (float)(-d12 * det);
-    result.m20 = (float)(+d13 * det);
-    result.m30 = (float)(-d14 * det);
-
-    result.m01 = (float)(-d21 * det);
-    result.m11 = (float)(+d22 * det);
-    result.m21 = (float)(-d23 * det);
-    result.m31 = (float)(+d24 * det);
-
-    result.m02 = (float)(+d31 * det);
-    result.m12 = (float)(-d32 * det);
-    result.m22 = (float)(+d33 * det);
-    result.m32 = (float)(-d34 * det);
-
+    result.set_row( 0, SIMD_SHUFFLE( X, Y, 3, 1, 3, 1 ) );
+    result.set_row( 1, SIMD_SHUFFLE( X, Y, 2, 0, 2, 0 ) );
+    result.set_row( 2, SIMD_SHUFFLE( Z, W, 3, 1, 3, 1 ) );
+    result.set_row( 3, SIMD_SHUFFLE( Z, W, 2, 0, 2, 0 ) );
     return result;
 }
 
 Matrix4f Matrix4f::operator-() const
 {
     Matrix4f result;
+    __m128 sign = _mm_set1_ps( -0.0f );
 
-    result.m00 = -m00;
-    result.m01 = -m01;
-    result.m02 = -m02;
-    result.m03 = -m03;
+    for ( uint32 i = 0; i < 4; ++i )
+        result.set_row( i, simd::negate( row( i ), sign ) );
 
-    result.m10 = -m10;
-    result.m11 = -m11;
-    result.m12 = -m12;
-    result.m13 = -m13;
+    return result;
+}
 
-    result.m20 = -m20;
-    result.m21 = -m21;
-    result.m22 = -m22;
-    result.m23 = -m23;
+Matrix4f Matrix4f::operator+(const Matrix4f& o) const
+{
+    Matrix4f result;
 
-    result.m30 = -m30;
-    result.m31 = -m31;
-    result.m32 = -m32;
-    result.m33 = -m33;
+    for ( uint32 i = 0; i < 4; ++i )
+        result.set_row( i, _mm_add_ps( row( i ), o.row( i ) ) );
 
     return result;
 }
 
-Matrix4f Matrix4f::operator+(Matrix4f o) const
+Matrix4f Matrix4f::operator-(const Matrix4f& o) const
 {
     Matrix4f result;
-    result.m00 = m00 + o.m00;
-    result.m01 = m01 + o.m01;
-    result.m02 = m02 + o.m02;
-    result.m03 = m03 + o.m03;
-
-    result.m10 = m10 + o.m10;
-    result.m11 = m11 + o.m11;
-    result.m12 = m12 + o.m12;
-    result.m13 = m13 + o.m13;
-
-    result.m20 = m20 + o.m20;
-    result.m21 = m21 + o.m21;
-    result.m22 = m22 + o.m22;
-    result.m23 = m23 + o.m23;
-
-    result.m30 = m30 + o.m30;
-    result.m31 = m31 + o.m31;
-    result.m32 = m32 + o.m32;
-    result.m33 = m33 + o.m33;
+
+    for ( uint32 i = 0; i < 4; ++i )
+        result.set_row( i, _mm_sub_ps( row( i ), o.row( i ) ) );
 
     return result;
 }
 
-Matrix4f Matrix4f::operator-(Matrix4f o) const
+Matrix4f Matrix4f::operator*(const Matrix4f& o) const
 {
+    // Row i of the result is our rows weighted by the fields of o's row i
+    __m128 r0 = row( 0 ), r1 = row( 1 ), r2 = row( 2 ), r3 = row( 3 );
     Matrix4f result;
-    result.m00 = m00 - o.m00;
-    result.m01 = m01 - o.m01;
-    result.m02 = m02 - o.m02;
-    result.m03 = m03 - o.m03;
-
-    result.m10 = m10 - o.m10;
-    result.m11 = m11 - o.m11;
-    result.m12 = m12 - o.m12;
-    result.m13 = m13 - o.m13;
-
-    result.m20 = m20 - o.m20;
-    result.m21 = m21 - o.m21;
-    result.m22 = m22 - o.m22;
-    result.m23 = m23 - o.m23;
-
-    result.m30 = m30 - o.m30;
-    result.m31 = m31 - o.m31;
-    result.m32 = m32 - o.m32;
-    result.m33 = m33 - o.m33;
+
+    for ( uint32 i = 0; i < 4; ++i ) {
+        __m128 w = o.row( i );
+        __m128 sum = _mm_add_ps( _mm_mul_ps( r0, SIMD_SPLAT( w, 0 ) ), _mm_mul_ps( r1, SIMD_SPLAT( w, 1 ) ) );
+        sum = _mm_add_ps( sum, _mm_add_ps( _mm_mul_ps( r2, SIMD_SPLAT( w, 2 ) ), _mm_mul_ps( r3, SIMD_SPLAT( w, 3 ) ) ) );
+        result.set_row( i, sum );
+    }
 
     return result;
 }
 
-Matrix4f Matrix4f::operator*(Matrix4f o) const
+Matrix4f Matrix4f::transposed() const
 {
-    Matrix4f result;
+    __m128 r0 = row( 0 ), r1 = row( 1 ), r2 = row( 2 ), r3 = row( 3 );
+    _MM_TRANSPOSE4_PS( r0, r1, r2, r3 );
 
-    result.m00 = m00 * o.m00 + m10 * o.m01 + m20 * o.m02 + m30 * o.m03;
-    result.m01 = m01 * o.m00 + m11 * o.m01 + m21 * o.m02 + m31 * o.m03;
-    result.m02 = m02 * o.m00 + m12 * o.m01 + m22 * o.m02 + m32 * o.m03;
-    result.m03 = m03 * o.m00 + m13 * o.m01 + m23 * o.m02 + m33 * o.m03;
-    result.m10 = m00 * o.m10 + m10 * o.m11 + m20 * o.m12 + m30 * o.m13;
-    result.m11 = m01 * o.m10 + m11 * o.m11 + m21 * o.m12 + m31 * o.m13;
-    result.m12 = m02 * o.m10 + m12 * o.m11 + m22 * o.m12 + m32 * o.m13;
-    result.m13 = m03 * o.m10 + m13 * o.m11 + m23 * o.m12 + m33 * o.m13;
-    result.m20 = m00 * o.m20 + m10 * o.m21 + m20 * o.m22 + m30 * o.m23;
-    result.m21 = m01 * o.m20 + m11 * o.m21 + m21 * o.m22 + m31 * o.m23;
-    result.m22 = m02 * o.m20 + m12 * o.m21 + m22 * o.m22 + m32 * o.m23;
-    result.m23 = m03 * o.m20 + m13 * o.m21 + m23 * o.m22 + m33 * o.m23;
-    result.m30 = m00 * o.m30 + m10 * o.m31 + m20 * o.m32 + m30 * o.m33;
-    result.m31 = m01 * o.m30 + m11 * o.m31 + m21 * o.m32 + m31 * o.m33;
-    result.m32 = m02 * o.m30 + m12 * o.m31 + m22 * o.m32 + m32 * o.m33;
-    result.m33 = m03 * o.m30 + m13 * o.m31 + m23 * o.m32 + m33 * o.m33;
+    Matrix4f result;
+    result.set_row( 0, r0 );
+    result.set_row( 1, r1 );
+    result.set_row( 2, r2 );
+    result.set_row( 3, r3 );
+    return result;
+}
 
+Vector3f Matrix4f::transform( const Vector3f& p ) const
+{
+    // Each output is one row dotted with ( p, 1 ), the transpose turns the four dots into three adds
+    __m128 v = _mm_setr_ps( p.x, p.y, p.z, 1.0f );
+    __m128 r0 = _mm_mul_ps( row( 0 ), v );
+    __m128 r1 = _mm_mul_ps( row( 1 ), v );
+    __m128 r2 = _mm_mul_ps( row( 2 ), v );
+    __m128 r3 = _mm_setzero_ps();
+    _MM_TRANSPOSE4_PS( r0, r1, r2, r3 );
+
+    Vector3f result;
+    simd::store3( &result.x, _mm_add_ps( _mm_add_ps( r0, r1 ), _mm_add_ps( r2, r3 ) ) );
     return result;
 }
 
@@ -421,22 +370,12 @@ Vector4f Matrix4f::to_quaternion_4f()
     return Vector4f( x, y, z, w );
 }
 
-std::vector<float> Matrix4f::row_major() const
+const float* Matrix4f::data() const
 {
-    return { m00, m10, m20, m30,
-             m01, m11, m21, m31,
-             m02, m12, m22, m32,
-             m03, m13, m23, m33 };
+    static_assert( sizeof( Matrix4f ) == 16 * sizeof( float ), "Matrix4f fields have to be packed" );
+    return &m00;
 }
 
-std::vector<float> Matrix4f::column_major() const
-{
-    return { m00, m01, m02, m03,
-             m10, m11, m12, m13,
-             m20, m21, m22, m23,
-             m30, m31, m32, m33 };
-} 
-
 std::ostream& operator<<( std::ostream &strm, const Matrix4f &m ) {
             strm << "[ " << m.m00 << ", " << m.m01 << "," << m.m02 << "," << m.m03 << " ]\n";
             strm << "[ " << m.m10 << ", " << m.m11 << "," << m.m12 << "," << m.m13 << " ]\n";
@@ -8,15 +8,17 @@
 
 // Internal Includes
 #include "_mathdefs.h"
+#include "simd.h"
 #include "vector3f.h"
 #include "vector4f.h"
 
 ENGINE_NAMESPACE_BEGIN
 
 /**
-* 
+* 16-byte aligned, each row of fields is one SSE register. Products,
+* transposes, inverses and transforms run on whole rows.
 */
-class Matrix4f
+class alignas(16) Matrix4f
 {
 public:
     static Matrix4f ZERO;
@@ -44,7 +46,6 @@ public:
     static Matrix4f look_at_rh( const Vector3f& eye, const Vector3f& target, const Vector3f& up );
 
             Matrix4f();
-            Matrix4f(Matrix4f& copy);
             Matrix4f( float v00, float v01, float v02, float v03,
                       float v10, float v11, float v12, float v13,
                       float v20, float v21, float v22, float v23,
@@ -53,20 +54,26 @@ public:
             ~Matrix4f() = default;
 
 
-    bool operator==(Matrix4f& o) const;
-    bool operator!=(Matrix4f& o) const;
+    bool operator==(const Matrix4f& o) const;
+    bool operator!=(const Matrix4f& o) const;
 
     Matrix4f operator!() const;
     Matrix4f operator-() const;
 
-    Matrix4f operator+(Matrix4f o) const;
-    Matrix4f operator-(Matrix4f o) const;
-    Matrix4f operator*(Matrix4f o) const;
+    Matrix4f operator+(const Matrix4f& o) const;
+    Matrix4f operator-(const Matrix4f& o) const;
+    Matrix4f operator*(const Matrix4f& o) const;
+
+    Matrix4f transposed() const;
+
+    // Point with w = 1, in the same convention the shaders use ( m03 is the x translation )
+    Vector3f transform( const Vector3f& point ) const;
 
     Vector4f /*Quaternion4f*/ to_quaternion_4f();
 
-    std::vector<float> column_major() const;
-    std::vector<float> row_major() const;
+    // The 16 fields in declaration order. Uploads read from here with transpose = false,
+    // transposed() gives the other order.
+    const float*       data() const;
 
     float m00, m01, m02, m03;
     float m10, m11, m12, m13;
@@ -74,7 +81,20 @@ public:
     float m30, m31, m32, m33;
 
 private:
+    __m128  row( uint32 i ) const;
+    void    set_row( uint32 i, __m128 v );
+
     friend std::ostream& operator<<( std::ostream&, const Matrix4f& );
 };
 
+inline __m128 Matrix4f::row( uint32 i ) const
+{
+    return _mm_load_ps( &m00 + 4 * i );
+}
+
+inline void Matrix4f::set_row( uint32 i, __m128 v )
+{
+    _mm_store_ps( &m00 + 4 * i, v );
+}
+
 ENGINE_NAMESPACE_END
\ No newline at end of file
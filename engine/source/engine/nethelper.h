@@ -100,7 +100,7 @@ inline void __net_write( std::vector<byte>& v, Vector4f value ) {
 }
 
 
-inline void __net_write( std::vector<byte>& v, Quaternion4f value ) {
+inline void __net_write( std::vector<byte>& v, const Quaternion4f& value ) {
     __net_write( v, value.x );
     __net_write( v, value.y );
     __net_write( v, value.z );
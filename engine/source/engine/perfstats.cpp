@@ -32,13 +32,19 @@ void PerfStats::check_if_second_is_over() {
         _numFPS = _counterFPS;
         _avgFrameTime = (_numFPS > 0) ? (_counterAvgFrameTime / _numFPS) : (-1ms);
 
+        // Polygons and draw calls are per frame, frame_start() resets them on the render thread
         _counterFPS = 0;
-        _counterPolygons = 0;
-        _counterDrawCalls = 0;
         _counterAvgFrameTime = 0ms;
 
+        _numOverBudgetTicks = _counterOverBudgetTicks;
+        _numDroppedTicks = _counterDroppedTicks;
+        _numMergedTicks = _counterMergedTicks;
+
         _counterTPS = 0;
         _counterAvgTickTime = 0ms;
+        _counterOverBudgetTicks = 0;
+        _counterDroppedTicks = 0;
+        _counterMergedTicks = 0;
 
         //cout << "FPS " << _numFPS << "\n";
         return;
@@ -49,12 +55,16 @@ void PerfStats::check_if_second_is_over() {
              << "\tAvg. Frame Time:   " << _avgFrameTime.count() << "ms\n"
              << "\tPolygons in scene: " << _numPolygons << "\n"
              << "\tDraw calls:        " << _numDrawCalls << "\n"
+             << "\tSkipped GL calls:  " << _numRedundantGLCalls << "\n"
              << "\tLoaded  Shaders:   " << _numLoadedShaders << "\n"
              << "\tLoaded Textures:   " << _numLoadedTextures << " (" << (_numLoadedTexturesBytes / 1024) << " kb)\n"
              << "------------------------------\n"
              << "LOGIC"
              << "\tTicks per sec.:    " << _numTPS << "\n"
              << "\tAvg. Tick Time:    " << _avgTickTime.count() << "ms\n"
+             << "\tOver budget:       " << _numOverBudgetTicks << "\n"
+             << "\tDropped ticks:     " << _numDroppedTicks << "\n"
+             << "\tMerged ticks:      " << _numMergedTicks << "\n"
              << "==============================\n\n";
     }
 }
@@ -7,6 +7,7 @@
 // Std-Includes
 #include <chrono>
 #include <ctime>
+#include <mutex>
 
 // Other Includes
 
@@ -43,12 +44,35 @@ public:
     }
 
     inline void tick_end() {
+        std::lock_guard<std::mutex> lock( _mutex );
         check_if_second_is_over();
 
         _counterTPS++;
 
-        milliseconds timeSpan = std::chrono::duration_cast<milliseconds>(clock_t::now() - _frameClockStart);
-        _counterAvgTickTime += timeSpan;
+        auto tickTime = clock_t::now() - _tickClockStart;
+        _counterAvgTickTime += std::chrono::duration_cast<milliseconds>(tickTime);
+
+        // Compared in the clock's own unit, a zero budget means none was set
+        if ( _tickBudget != clock_t::duration::zero() && tickTime > _tickBudget )
+            _counterOverBudgetTicks++;
+    }
+
+    // TICK BUDGET, zero for none
+    inline void set_tick_budget( std::chrono::microseconds budget ) {
+        std::lock_guard<std::mutex> lock( _mutex );
+        _tickBudget = std::chrono::duration_cast<clock_t::duration>( budget );
+    }
+
+    // Ticks the fixed-step loop skipped to recover from a stall
+    inline void ticks_dropped( size_t numTicks ) {
+        std::lock_guard<std::mutex> lock( _mutex );
+        _counterDroppedTicks += numTicks;
+    }
+
+    // Ticks the fixed-step loop folded into a longer tick
+    inline void ticks_merged( size_t numTicks ) {
+        std::lock_guard<std::mutex> lock( _mutex );
+        _counterMergedTicks += numTicks;
     }
 
     // FRAME
@@ -56,8 +80,10 @@ public:
         _frameClockStart = clock_t::now();
         _numPolygons = _counterPolygons;
         _numDrawCalls = _counterDrawCalls;
+        _numRedundantGLCalls = _counterRedundantGLCalls;
         _counterPolygons = 0;
         _counterDrawCalls = 0;
+        _counterRedundantGLCalls = 0;
     }
 
     inline void frame_gpu_call() {
@@ -69,6 +95,11 @@ public:
         _counterPolygons += numPolygons;
     }
 
+    // A GL call GLStateCache skipped, since it wouldn't have changed anything
+    inline void frame_redundant_gl_call() {
+        _counterRedundantGLCalls++;
+    }
+
     inline void frame_load_texture( size_t imgDataBytes) {
         _numLoadedTextures++;
         _numLoadedTexturesBytes += imgDataBytes;
@@ -88,6 +119,7 @@ public:
     }
 
     inline void frame_end() {
+        std::lock_guard<std::mutex> lock( _mutex );
         check_if_second_is_over();
 
         _counterFPS++;
@@ -100,6 +132,28 @@ public:
         return _numFPS;
     }
 
+    inline size_t get_tps() {
+        return _numTPS;
+    }
+
+    // Per second, over the last full second
+    inline size_t get_over_budget_ticks() {
+        return _numOverBudgetTicks;
+    }
+
+    inline size_t get_dropped_ticks() {
+        return _numDroppedTicks;
+    }
+
+    inline size_t get_merged_ticks() {
+        return _numMergedTicks;
+    }
+
+    // Over the last frame
+    inline size_t get_redundant_gl_calls() {
+        return _numRedundantGLCalls;
+    }
+
 protected:
     /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
     /*                       Protected                        */
@@ -111,8 +165,11 @@ private:
     /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
             PerfStats();
 
+            // Caller holds _mutex, ticks and frames end on different threads
             void   check_if_second_is_over();
 
+    std::mutex _mutex;
+
             size_t _numLoadedShaders;
     size_t _numLoadedTextures;
     size_t _numLoadedTexturesBytes;
@@ -126,9 +183,21 @@ private:
     size_t _numDrawCalls;
     size_t _counterDrawCalls;
 
+    size_t _numRedundantGLCalls;
+    size_t _counterRedundantGLCalls;
+
     size_t _numTPS;
     size_t _counterTPS;
 
+    size_t _numOverBudgetTicks;
+    size_t _counterOverBudgetTicks;
+    size_t _numDroppedTicks;
+    size_t _counterDroppedTicks;
+    size_t _numMergedTicks;
+    size_t _counterMergedTicks;
+
+    clock_t::duration _tickBudget = clock_t::duration::zero();
+
     milliseconds _avgFrameTime;
     milliseconds _counterAvgFrameTime;
     milliseconds _avgTickTime;
@@ -6,7 +6,7 @@ Entity Player_Spawner::Spawn( LogicEngine& logic, weak<RenderEngine> rendering,
     // LOGIC
     Entity player = Entity::New();
     auto& trans = player.add<CTransform>();
-    trans.position = Vector3f(4, 4, 0);
+    trans.position() = Vector3f(4, 4, 0);
 
     auto& ctrl = player.add<CControllable>();
     ctrl.name = "Player";
@@ -14,12 +14,11 @@ void PlayerController::set_entity( Entity pEntity )
 
 void PlayerController::update( std::vector<KeyEvent>& keys, std::vector<CharEvent>& chars, std::vector<MouseEvent>& mouse )
 {
-    if ( !entity.has<CControllable>() ) return;
-
-    CControllable& ctrl = entity.get<CControllable>();
+    CControllable* ctrl = entity.try_get<CControllable>();
+    if ( ctrl == nullptr ) return;
 
     for ( auto& key : keys ) {
-        handleWASD( ctrl, key );
+        handleWASD( *ctrl, key );
     }
 }
 
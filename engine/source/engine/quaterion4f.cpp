@@ -17,14 +17,6 @@ Quaternion4f Quaternion4f::slerp( const Quaternion4f& pQuat0, const Quaternion4f
     // Compute the cosine of the angle between the two vectors.
     double dot = dot_product( q0, q1 );
 
-    const double DOT_THRESHOLD = 0.9995;
-    if ( fabs( dot ) > DOT_THRESHOLD ) {
-        // If the inputs are too close for comfort, linearly interpolate
-        // and normalize the result.
-        Quaternion4f result = q0 + amount * (q1 - q0);
-        return result.normalized();
-    }
-
     // If the dot product is negative, the quaternions
     // have opposite handed-ness and slerp won't take
     // the shorter path. Fix by reversing one quaternion.
@@ -33,6 +25,14 @@ Quaternion4f Quaternion4f::slerp( const Quaternion4f& pQuat0, const Quaternion4f
         dot = -dot;
     }
 
+    const double DOT_THRESHOLD = 0.9995;
+    if ( dot > DOT_THRESHOLD ) {
+        // If the inputs are too close for comfort, linearly interpolate
+        // and normalize the result.
+        Quaternion4f result = q0 + amount * (q1 - q0);
+        return result.normalized();
+    }
+
     dot = std::min( std::max( dot, -1.0), 1.0 );    // Robustness: Stay within domain of acos()
     double theta_0 = acos( dot );  // theta_0 = angle between input vectors
     double theta = theta_0 * amount;    // theta = angle between v0 and result 
@@ -49,6 +49,10 @@ Quaternion4f Quaternion4f::rotation_axis( const Vector3f& axis, float angle ) {
     return Quaternion4f( axis.x * s, axis.y * s, axis.z * s, (float)cos( angle / 2 ) );
 }
 
+float Quaternion4f::to_z_angle( const Quaternion4f& q ) {
+    return 2.0f * std::atan2( q.z, q.w );
+}
+
 Matrix4f Quaternion4f::to_rotation_mat4f( const Quaternion4f& q ) {
     Matrix4f out( 0.0f );
 
@@ -89,7 +93,7 @@ Matrix4f Quaternion4f::to_rotation_mat4f( const Quaternion4f& q ) {
 
 float Quaternion4f::dot_product( const Quaternion4f& pQuat0 , const Quaternion4f& pQuat1 )
 {
-    return pQuat0.x * pQuat1.x + pQuat0.y * pQuat1.y + pQuat0.z * pQuat1.z + pQuat0.w * pQuat1.w;
+    return _mm_cvtss_f32( simd::dot4( pQuat0.load(), pQuat1.load() ) );
 }
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
@@ -101,7 +105,7 @@ Quaternion4f::Quaternion4f(const float x, const float y, const float z, const fl
 
 bool Quaternion4f::operator==(const Quaternion4f & o) const
 {
-    return x == o.x && y == o.y && z == o.z && w == w;
+    return _mm_movemask_ps( _mm_cmpeq_ps( load(), o.load() ) ) == 0xF;
 }
 
 bool Quaternion4f::operator!=(const Quaternion4f & o) const
@@ -111,93 +115,81 @@ bool Quaternion4f::operator!=(const Quaternion4f & o) const
 
 Quaternion4f Quaternion4f::operator-() const
 {
-    return Quaternion4f(-x, -y, -z, w);
+    // All four lanes, q and -q are the same rotation. slerp() relies on this for the shorter path.
+    return from( simd::negate( load(), _mm_set1_ps( -0.0f ) ) );
 }
 
 Quaternion4f Quaternion4f::operator*(const float o) const
 {
-    return Quaternion4f(x * o, y * o, z * o, w * o);
+    return from( _mm_mul_ps( load(), _mm_set1_ps( o ) ) );
 }
 
-Quaternion4f Quaternion4f::operator+(const Quaternion4f o) const
+Quaternion4f Quaternion4f::operator+(const Quaternion4f& o) const
 {
-    Quaternion4f result = *this;
-    result += o;
-    return result;
+    return from( _mm_add_ps( load(), o.load() ) );
 }
 
-Quaternion4f Quaternion4f::operator-(const Quaternion4f o) const
+Quaternion4f Quaternion4f::operator-(const Quaternion4f& o) const
 {
-    Quaternion4f result = *this;
-    result -= o;
-    return result;
+    return from( _mm_sub_ps( load(), o.load() ) );
 }
 
-Quaternion4f Quaternion4f::operator*(const Quaternion4f o) const
+Quaternion4f Quaternion4f::operator*(const Quaternion4f& o) const
 {
-    Quaternion4f result = *this;
-    result *= o;
-    return result;
+    // Each lane of *this scales a sign-flipped swizzle of o
+    __m128 a = load();
+    __m128 b = o.load();
+
+    __m128 bx = simd::negate( SIMD_SWIZZLE( b, 3, 2, 1, 0 ), _mm_setr_ps(  0.0f, -0.0f,  0.0f, -0.0f ) );
+    __m128 by = simd::negate( SIMD_SWIZZLE( b, 2, 3, 0, 1 ), _mm_setr_ps(  0.0f,  0.0f, -0.0f, -0.0f ) );
+    __m128 bz = simd::negate( SIMD_SWIZZLE( b, 1, 0, 3, 2 ), _mm_setr_ps( -0.0f,  0.0f,  0.0f, -0.0f ) );
+
+    __m128 result = _mm_add_ps( _mm_mul_ps( SIMD_SPLAT( a, 0 ), bx ), _mm_mul_ps( SIMD_SPLAT( a, 1 ), by ) );
+    result = _mm_add_ps( result, _mm_add_ps( _mm_mul_ps( SIMD_SPLAT( a, 2 ), bz ), _mm_mul_ps( SIMD_SPLAT( a, 3 ), b ) ) );
+
+    return from( result );
 }
 
 Quaternion4f& Quaternion4f::operator*=(const float o)
 {
-    x = x * o;
-    y = y * o;
-    z = z * o;
-    w = w * o;
-
+    store( _mm_mul_ps( load(), _mm_set1_ps( o ) ) );
     return *this;
 }
 
-Quaternion4f& Quaternion4f::operator+=(const Quaternion4f o)
+Quaternion4f& Quaternion4f::operator+=(const Quaternion4f& o)
 {
-    x += o.x;
-    y += o.y;
-    z += o.z;
-    w += o.w;
+    store( _mm_add_ps( load(), o.load() ) );
     return *this;
 }
 
-Quaternion4f& Quaternion4f::operator-=(const Quaternion4f o)
+Quaternion4f& Quaternion4f::operator-=(const Quaternion4f& o)
 {
-    x -= o.x;
-    y -= o.y;
-    z -= o.z;
-    w -= o.w;
+    store( _mm_sub_ps( load(), o.load() ) );
     return *this;
 }
 
-Quaternion4f& Quaternion4f::operator*=(const Quaternion4f o)
+Quaternion4f& Quaternion4f::operator*=(const Quaternion4f& o)
 {
-    float _x = x;
-    float _y = y;
-    float _z = z;
-    float _w = w;
-
-    x =  _x * o.w + _y * o.z - _z * o.y + _w * o.x;
-    y = -_x * o.z + _y * o.w + _z * o.x + _w * o.y;
-    z =  _x * o.y - _y * o.x + _z * o.w + _w * o.z;
-    w = -_x * o.x - _y * o.y - _z * o.z + _w * o.w;
-
+    *this = *this * o;
     return *this;
 }
 
 float Quaternion4f::length() const
 {
-    return sqrtf(x*x + y*y + z*z + w*w);
+    return _mm_cvtss_f32( _mm_sqrt_ss( simd::dot4( load(), load() ) ) );
 }
 
 Quaternion4f Quaternion4f::normalized() const
 {
-    float length = this->length();
-    if (length == 0.0f)
+    __m128 v = load();
+    __m128 length = _mm_sqrt_ps( simd::dot4( v, v ) );
+
+    if ( _mm_cvtss_f32( length ) == 0.0f )
     {
         return *this;
     }
 
-    float inverse = 1.0f / length;
-    return Quaternion4f(x*inverse, y*inverse, z*inverse, w*inverse);
+    return from( _mm_div_ps( v, length ) );
 }
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
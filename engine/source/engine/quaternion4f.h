@@ -13,13 +13,15 @@
 #include "_global.h"
 #include "vector3f.h"
 #include "matrix4f.h"
+#include "simd.h"
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 /*                         Class                          */
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 ENGINE_NAMESPACE_BEGIN
 
-class Quaternion4f
+// 16-byte aligned, x y z w are one SSE register
+class alignas(16) Quaternion4f
 {
 public:
 
@@ -38,9 +40,12 @@ public:
 
     static Matrix4f to_rotation_mat4f( const Quaternion4f& q );
 
+    // Angle in radians around Z, the only rotation 2D renderers use
+    static float to_z_angle( const Quaternion4f& q );
+
     static Quaternion4f rotationIdentity() { return std::move( Quaternion4f(0.0f, 0.0f, 0.0f, 1.0f) ); }
 
-    static inline float dot_product( const Quaternion4f&, const Quaternion4f& );
+    static float dot_product( const Quaternion4f&, const Quaternion4f& );
 
     /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
     /*                        Public                          */
@@ -56,15 +61,15 @@ public:
 
     Quaternion4f operator*(const float o) const;
 
-    Quaternion4f operator+(const Quaternion4f o) const;
-    Quaternion4f operator-(const Quaternion4f o) const;
-    Quaternion4f operator*(const Quaternion4f o) const;
+    Quaternion4f operator+(const Quaternion4f& o) const;
+    Quaternion4f operator-(const Quaternion4f& o) const;
+    Quaternion4f operator*(const Quaternion4f& o) const;
 
     Quaternion4f& operator*=(const float o);
 
-    Quaternion4f& operator+=(const Quaternion4f o);
-    Quaternion4f& operator-=(const Quaternion4f o);
-    Quaternion4f& operator*=(const Quaternion4f o);
+    Quaternion4f& operator+=(const Quaternion4f& o);
+    Quaternion4f& operator-=(const Quaternion4f& o);
+    Quaternion4f& operator*=(const Quaternion4f& o);
 
     float         length() const;
     Quaternion4f  normalized() const;
@@ -78,8 +83,29 @@ private:
     /*                        Private                         */
     /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
+    __m128  load() const;
+    void    store( __m128 v );
+
+    static Quaternion4f from( __m128 v );
 };
 
+inline __m128 Quaternion4f::load() const
+{
+    return _mm_load_ps( &x );
+}
+
+inline void Quaternion4f::store( __m128 v )
+{
+    _mm_store_ps( &x, v );
+}
+
+inline Quaternion4f Quaternion4f::from( __m128 v )
+{
+    Quaternion4f result;
+    result.store( v );
+    return result;
+}
+
 inline Quaternion4f operator*( const float& a, const Quaternion4f& b ) { return b * a; }
 
 ENGINE_NAMESPACE_END
@@ -16,19 +16,19 @@ Range::Range(uint32 start, uint32 length)
 {
 }
 
-uint32 Range::start() {
+uint32 Range::start() const {
     return _start;
 }
 
-uint32 Range::length() {
+uint32 Range::length() const {
     return _length;
 }
 
-uint32 Range::index() {
+uint32 Range::index() const {
     return _start;
 }
 
-uint32 Range::last_index() {
+uint32 Range::last_index() const {
     if (_length == 0) {
         return _start;
     }
@@ -38,7 +38,7 @@ uint32 Range::last_index() {
 
 bool Range::operator!=(const Range& o) const
 {
-    return _start != o._start || _length != _length;
+    return _start != o._start || _length != o._length;
 }
 
 bool Range::operator==(const Range& o) const
@@ -27,11 +27,11 @@ public:
             Range(uint32 start, uint32 length);
             ~Range() = default;
 
-    uint32  start();
-    uint32  length();
+    uint32  start() const;
+    uint32  length() const;
 
-    uint32  index();
-    uint32  last_index();
+    uint32  index() const;
+    uint32  last_index() const;
 
     void    move(uint32 distance);
 
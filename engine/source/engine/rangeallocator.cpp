@@ -0,0 +1,101 @@
+#include "stdafx.h"
+#include "rangeallocator.h"
+
+ENGINE_NAMESPACE_BEGIN
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                          Public                        */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+RangeAllocator::RangeAllocator( uint32 capacity )
+    : _capacity( 0 ), _used( 0 )
+{
+    grow( capacity );
+}
+
+optional<Range> RangeAllocator::allocate( uint32 length )
+{
+    return allocate_below( length, _capacity );
+}
+
+optional<Range> RangeAllocator::allocate_below( uint32 length, uint32 end )
+{
+    Requires( length > 0 );
+
+    for ( auto it = _free.begin(); it != _free.end() && it->first + length <= end; ++it ) {
+        if ( it->second < length ) continue;
+
+        // Take the front of the hole, the rest stays free
+        Range range( it->first, length );
+        uint32 rest = it->second - length;
+
+        _free.erase( it );
+        if ( rest > 0 ) _free[range.start() + length] = rest;
+
+        _used += length;
+        return range;
+    }
+
+    return std::nullopt;
+}
+
+void RangeAllocator::free( Range range )
+{
+    Requires( range.start() + range.length() <= _capacity );
+    Guard( range.length() > 0 ) return;
+
+    uint32 start  = range.start();
+    uint32 length = range.length();
+
+    // 1# Merge with the following hole
+    auto next = _free.lower_bound( start );
+    Assert( next == _free.end() || next->first >= start + length );
+
+    if ( next != _free.end() && next->first == start + length ) {
+        length += next->second;
+        next = _free.erase( next );
+    }
+
+    // 2# Merge with the preceding hole
+    if ( next != _free.begin() ) {
+        auto prev = std::prev( next );
+        Assert( prev->first + prev->second <= start );
+
+        if ( prev->first + prev->second == start ) {
+            prev->second += length;
+            _used -= range.length();
+            return;
+        }
+    }
+
+    _free[start] = length;
+    _used -= range.length();
+}
+
+void RangeAllocator::grow( uint32 newCapacity )
+{
+    Guard( newCapacity > _capacity ) return;
+
+    uint32 oldCapacity = _capacity;
+    _capacity = newCapacity;
+
+    // The new space counts as used until free() merges it in
+    _used += newCapacity - oldCapacity;
+    free( Range( oldCapacity, newCapacity - oldCapacity ) );
+}
+
+uint32 RangeAllocator::capacity() const
+{
+    return _capacity;
+}
+
+uint32 RangeAllocator::used() const
+{
+    return _used;
+}
+
+bool RangeAllocator::empty() const
+{
+    return _used == 0;
+}
+
+ENGINE_NAMESPACE_END
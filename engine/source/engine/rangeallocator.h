@@ -0,0 +1,56 @@
+#pragma once
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                        Includes                        */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+// Std-Includes
+#include <map>
+
+// Internal Includes
+#include "_global.h"
+#include "range.h"
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Class                          */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+ENGINE_NAMESPACE_BEGIN
+
+// Hands out ranges of [0, capacity) from a free-list, first fit.
+// Freed ranges merge with their free neighbours, so the list holds at
+// most one entry per hole. Only bookkeeping, the memory lives elsewhere.
+class RangeAllocator {
+public:
+    /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+    /*                        Public                          */
+    /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+                    explicit RangeAllocator( uint32 capacity = 0 );
+                    ~RangeAllocator() = default;
+
+    optional<Range> allocate( uint32 length );
+
+    // First fit that ends at or before end, e.g. to move a range towards the front
+    optional<Range> allocate_below( uint32 length, uint32 end );
+
+    void            free( Range range );
+
+    // Appends [capacity, newCapacity) as free space
+    void            grow( uint32 newCapacity );
+
+    uint32          capacity() const;
+    uint32          used() const;
+    bool            empty() const;
+
+private:
+    /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+    /*                       Private                          */
+    /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+    // Free ranges, start -> length
+    std::map<uint32, uint32> _free;
+
+    uint32 _capacity;
+    uint32 _used;
+};
+
+ENGINE_NAMESPACE_END
@@ -31,11 +31,22 @@ Rect4f::Rect4f( float pX, float pY, float pWidth, float pHeight )
     set_height( pHeight );
 }
 
-bool Rect4f::operator==( Rect4f & o ) const
+bool Rect4f::operator==( const Rect4f& o ) const
 {
     return _minX == o._minX && _minY == o._minY && _width == o._width && _height == o._height;
 }
 
+bool Rect4f::operator!=( const Rect4f& o ) const
+{
+    return !(*this == o);
+}
+
+bool Rect4f::overlaps( const Rect4f& o ) const
+{
+    return min_x() <= o.max_x() && o.min_x() <= max_x()
+        && min_y() <= o.max_y() && o.min_y() <= max_y();
+}
+
 float Rect4f::x() const
 {
     return _minX;
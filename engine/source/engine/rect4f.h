@@ -28,13 +28,17 @@ public:
     /*                        Public                          */
     /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
-                Rect4f( Rect4f& copy);
+                Rect4f( const Rect4f& copy ) = default;
                 Rect4f( float pX, float pY, float pWidth, float pHeight);
             ~Rect4f() = default;
 
+    Rect4f& operator=( const Rect4f& o ) = default;
 
-    bool operator==( Rect4f& o) const;
-    bool operator!=( Rect4f& o) const;
+    bool operator==( const Rect4f& o) const;
+    bool operator!=( const Rect4f& o) const;
+
+    // Touching edges count as overlapping
+    bool  overlaps( const Rect4f& o ) const;
 
 
     float x() const;
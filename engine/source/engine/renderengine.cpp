@@ -21,6 +21,10 @@ void RenderEngine::on_start( weak<InputEngine> input )
     }
 
 	  setup_builtin_shaders();
+    _gpuHeap      = make_owner<GpuHeap>();
+    _streamBuffer = make_owner<StreamBuffer>();
+    _spriteBatch  = make_owner<SpriteBatch>( _streamBuffer.get_non_owner() );
+    _cameraUniforms = make_owner<CameraUniforms>();
 
     // 2# Setup callbacks
     if ( input.is_ptr_valid() && input != nullptr ) {
@@ -93,11 +97,16 @@ void RenderEngine::on_render( float extrapolation )
     }
 
 
-    // 3# Render Scene
+    // 3# Render Scene, after tidying the heap as renderers look up their slices while drawing,
+    //    and with all transforms interpolated in one pass
+    _gpuHeap->compact( HEAP_COMPACT_BUDGET );
+    _worldTransforms.update( get_snapshot(), extrapolation, _jobs.get() );
+
     for ( auto& scene : _scenes ) {
         scene->render( *this, extrapolation );
     }
 
+    _streamBuffer->end_frame();
     _mainWindow->swap_buffers();
 
     // 4# Update GUI
@@ -107,6 +116,10 @@ void RenderEngine::on_render( float extrapolation )
 void RenderEngine::on_shutdown()
 {
     unload_everything();
+    _cameraUniforms.destroy();
+    _spriteBatch.destroy();
+    _streamBuffer.destroy();
+    _gpuHeap.destroy();
     destroy_context_and_window();
 }
 
@@ -115,6 +128,45 @@ weak<GLWindow> RenderEngine::get_window()
     return _mainWindow.get_non_owner();
 }
 
+void RenderEngine::set_snapshot( const RenderSnapshot& snapshot )
+{
+    _snapshot = &snapshot;
+}
+
+const RenderSnapshot& RenderEngine::get_snapshot() const
+{
+    Requires( _snapshot != nullptr );
+    return *_snapshot;
+}
+
+const WorldTransforms& RenderEngine::get_world_transforms() const
+{
+    return _worldTransforms;
+}
+
+SpriteBatch& RenderEngine::get_sprite_batch()
+{
+    Requires( _spriteBatch != nullptr );
+    return *_spriteBatch;
+}
+
+weak<GpuHeap> RenderEngine::get_gpu_heap()
+{
+    return _gpuHeap.get_non_owner();
+}
+
+StreamBuffer& RenderEngine::get_stream_buffer()
+{
+    Requires( _streamBuffer != nullptr );
+    return *_streamBuffer;
+}
+
+CameraUniforms& RenderEngine::get_camera_uniforms()
+{
+    Requires( _cameraUniforms != nullptr );
+    return *_cameraUniforms;
+}
+
 bool RenderEngine::is_exit_requested()
 {
     return  _mainWindow->close_requested();
@@ -227,14 +279,18 @@ void RenderEngine::init_context_and_window()
     _mainWindow->make_current();
     std::cout << "Using OpenGL Version " << glGetString(GL_VERSION) << "\n";
 
+    // Fresh context, nothing bound yet
+    GLStateCache& gl = GLStateCache::instance();
+    gl.reset();
+
     // Enable transparency
-    glEnable( GL_BLEND );
-    glBlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
+    gl.set_enabled( GL_BLEND, true );
+    gl.blend_func( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
     glEnable( GL_ALPHA_TEST );
     glAlphaFunc( GL_GREATER, 0 );
 
     // Depth
-    glEnable( GL_DEPTH_TEST );
+    gl.set_enabled( GL_DEPTH_TEST, true );
     glDepthFunc( GL_LEQUAL );
 }
 
@@ -264,7 +320,7 @@ void RenderEngine::setup_builtin_shaders()
 
     owner<Shader> colorShader = owner<Shader>(new Shader( 
                   /* VertexLayout  */   Vertex_pc().layout,
-                  /* VertexUniform */   { Uniform::WORLD_VIEW_PROJ_MATRIX }, 
+                  /* VertexUniform */   { Uniform::WORLD_MATRIX, Uniform::WORLD_DEPTH }, 
                   /* FragUniform   */   {}, 
                   /* Texture Slots */   {}, 
                   /* Vertex Shader */   csVertexShader.str(), 
@@ -282,9 +338,10 @@ void RenderEngine::setup_builtin_shaders()
 		<< "\n"
 		<< "void main() {\n"
 //#ifdef MAT4_ROW_MAJOR
-//		<< "    gl_Position = " << Uniform::WORLD_VIEW_PROJ_MATRIX.gl_varname() << " * vec4(position, 1.0);\n"
+//		<< "    gl_Position = uni_projview * " << Uniform::WORLD_MATRIX.gl_varname() << " * vec4(position, 1.0);\n"
 //#else
-        << "    gl_Position = vec4(position, 1.0) * " << Uniform::WORLD_VIEW_PROJ_MATRIX.gl_varname() << ";\n"
+        << "    vec2 world  = vec3(position.xy, 1.0) * " << Uniform::WORLD_MATRIX.gl_varname() << ";\n"
+        << "    gl_Position = vec4(world, position.z + " << Uniform::WORLD_DEPTH.gl_varname() << ", 1.0) * uni_projview;\n"
 //#endif
 		<< "    fs_texcoords = texcoords;\n"
 		<< "}\n";
@@ -303,7 +360,7 @@ void RenderEngine::setup_builtin_shaders()
 
     owner<Shader> texShader = owner<Shader>( new Shader(
         /* VertexLayout  */   Vertex_pt().layout,
-        /* VertexUniform */   { Uniform::WORLD_VIEW_PROJ_MATRIX },
+        /* VertexUniform */   { Uniform::WORLD_MATRIX, Uniform::WORLD_DEPTH },
         /* FragUniform   */   {},
         /* Texture Slots */   { TextureSlot::TEXTURE_DIFFUSE },
         /* Vertex Shader */   tsVertexShader.str(),
@@ -311,6 +368,45 @@ void RenderEngine::setup_builtin_shaders()
     ) );
 
 	add_shader("builtin_texture", std::move( texShader ));
+
+	// SPRITE SHADER
+	///////////
+	// Instanced unit quad, see Vertex_sprite
+    std::ostringstream ssVertexShader;
+	ssVertexShader
+		<< "out vec2 fs_texcoords;\n"
+		<< "out vec4 fs_tint;\n"
+		<< "\n"
+		<< "void main() {\n"
+		<< "    vec2 world = vec3(corner, 1.0) * mat2x3(i_world0, i_world1);\n"
+		<< "    world = vec3(world, 1.0) * " << Uniform::WORLD_MATRIX.gl_varname() << ";\n"
+		<< "\n"
+        << "    gl_Position = vec4(world, i_depth + " << Uniform::WORLD_DEPTH.gl_varname() << ", 1.0) * uni_projview;\n"
+		<< "    fs_texcoords = mix(i_uvrect.xy, i_uvrect.zw, corner);\n"
+		<< "    fs_tint = i_tint;\n"
+		<< "}\n";
+
+    std::ostringstream ssFragmentShader;
+	ssFragmentShader
+		<< "in vec2 fs_texcoords;\n"
+		<< "in vec4 fs_tint;\n"
+		<< "\n"
+		<< "out vec4 out_color;\n"
+		<< "\n"
+		<< "void main() {\n"
+		<< "    out_color = texture(" << TextureSlot::TEXTURE_DIFFUSE.name << ", fs_texcoords) * fs_tint;\n"
+		<< "}\n";
+
+    owner<Shader> spriteShader = owner<Shader>( new Shader(
+        /* VertexLayout  */   Vertex_sprite().layout,
+        /* VertexUniform */   { Uniform::WORLD_MATRIX, Uniform::WORLD_DEPTH },
+        /* FragUniform   */   {},
+        /* Texture Slots */   { TextureSlot::TEXTURE_DIFFUSE },
+        /* Vertex Shader */   ssVertexShader.str(),
+        /* Frag Shader   */   ssFragmentShader.str()
+    ) );
+
+	add_shader("builtin_sprite", std::move( spriteShader ));
 }
 
 void RenderEngine::destroy_context_and_window()
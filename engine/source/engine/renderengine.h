@@ -28,6 +28,7 @@
 
 #include "vertex_pc.h"
 #include "vertex_pt.h"
+#include "vertex_sprite.h"
 #include "textureslot.h"
 
 #include "imageutils.h"
@@ -36,6 +37,13 @@
 #include "glbuffer.h"
 
 #include "scene.h"
+#include "rendersnapshot.h"
+#include "spritebatch.h"
+#include "streambuffer.h"
+#include "gpuheap.h"
+#include "camerauniforms.h"
+#include "worldtransforms.h"
+#include "jobsystem.h"
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 /*                         Class                          */
@@ -56,7 +64,7 @@ public:
     /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
     /*                        Public                          */
     /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
-            RenderEngine() {}
+            explicit RenderEngine( weak<JobSystem> jobs ) : _jobs( jobs ), _snapshot( nullptr ) {}
             ~RenderEngine() {}
 
     // GENERAL
@@ -70,6 +78,26 @@ public:
     bool                is_exit_requested();
     void                hide_cursor( bool hideCursor );
     weak<GLWindow>      get_window();
+
+    // Snapshot of the frame being rendered, renderers read logic state only through it
+    void                  set_snapshot( const RenderSnapshot& snapshot );
+    const RenderSnapshot& get_snapshot() const;
+
+    // Interpolated poses and world matrices of all entities, updated before the scenes render
+    const WorldTransforms& get_world_transforms() const;
+
+    // Sprites queue up here and are drawn at the end of each camera pass
+    SpriteBatch&          get_sprite_batch();
+
+    // Ring for per-frame vertex data, fenced once per frame
+    StreamBuffer&         get_stream_buffer();
+
+    // Long-lived geometry shared by all renderers
+    weak<GpuHeap>         get_gpu_heap();
+
+    // Proj-view and viewport of the camera being rendered, for all shaders
+    CameraUniforms&       get_camera_uniforms();
+
     owner<Texture>      load_texture( string filename, TextureOptions options = TextureOptions() );
 
     // RESOURCES
@@ -95,7 +123,18 @@ private:
     void setup_builtin_shaders();
     void destroy_context_and_window();
 
+    // Bytes of heap allocations moved per frame at most
+    static const uint32 HEAP_COMPACT_BUDGET = 64 * 1024;
+
     owner<GLWindow> _mainWindow;
+    owner<GpuHeap>      _gpuHeap;
+    owner<StreamBuffer> _streamBuffer;
+    owner<SpriteBatch>  _spriteBatch;
+    owner<CameraUniforms> _cameraUniforms;
+
+    weak<JobSystem>       _jobs;
+    const RenderSnapshot* _snapshot;
+    WorldTransforms       _worldTransforms;
 
     std::vector<owner<Scene>>            _scenes;
     std::map< string, owner<Texture> >	 _textures;
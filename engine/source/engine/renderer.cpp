@@ -4,7 +4,7 @@
 ENGINE_NAMESPACE_BEGIN
 
 Renderer::Renderer()
-  : _initialized(false)
+  : _initialized(false), _renderlayer(0), _boundsDirty(nullptr), _boundsIndex(0)
 {
 
 }
@@ -45,6 +45,7 @@ Entity Renderer::get_entity() const
 void Renderer::set_entity(Entity pEntity)
 {
   _entity = pEntity;
+  mark_bounds_changed();
 }
 
 int32  Renderer::render_layer() const {
@@ -55,6 +56,45 @@ void Renderer::set_render_layer( int32 renderlayer ) {
     _renderlayer = renderlayer;
 }
 
+void Renderer::track_bounds( std::vector<uint32>* dirty, uint32 index ) {
+    _boundsDirty = dirty;
+    _boundsIndex = index;
+}
+
+void Renderer::mark_bounds_changed() {
+    Guard( _boundsDirty != nullptr ) return;
+    _boundsDirty->push_back( _boundsIndex );
+}
+
+const Material* Renderer::render_material() const {
+    return nullptr;
+}
+
+optional<Rect4f> Renderer::local_bounds( const RenderSnapshot& ) const {
+    return std::nullopt;
+}
+
+bool Renderer::batches_sprites() const {
+    return false;
+}
+
+float Renderer::render_layer_priority( const WorldTransforms& transforms ) const {
+    uint32 index = transforms.index_of( _entity );
+    return index != WorldTransforms::NO_INDEX ? transforms.pose( index ).position.z : FLT_MAX;
+}
+
+uint64 Renderer::sort_key( const WorldTransforms& transforms ) const {
+    uint32 shader  = 0;
+    uint32 texture = 0;
+
+    if ( const Material* material = render_material() ) {
+        if ( auto s = material->get_shader() )          shader  = s->id();
+        if ( auto t = material->get_texture_diffuse() ) texture = t->id();
+    }
+
+    return RenderQueue::sort_key( _renderlayer, render_layer_priority( transforms ), shader, texture );
+}
+
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 /*                     Private Static                     */
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
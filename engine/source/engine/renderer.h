@@ -5,12 +5,16 @@
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
 // Std-Includes
+#include <cfloat>
+#include <vector>
 
 // Other Includes
 
 // Internal Includes
 #include "_global.h"
 #include "renderengine.h"
+#include "renderqueue.h"
+#include "rect4f.h"
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 /*                         Class                          */
@@ -18,6 +22,8 @@
 ENGINE_NAMESPACE_BEGIN
 
 class RenderEngine;
+class RenderSnapshot;
+class WorldTransforms;
 
 //
 // - Handles ownership of rendering resources
@@ -42,9 +48,32 @@ public:
     void    set_render_layer( int32 layer );
 
 
-    virtual float render_layer_priority() const = 0;
+    // Orders renderers within a layer. By default the depth of the entity's
+    // interpolated transform this frame, FLT_MAX without one.
+    virtual float render_layer_priority( const WorldTransforms& transforms ) const;
+
+    // Material the renderer draws with, if any, to group equal state in the sort key
+    virtual const Material* render_material() const;
+
+    // What the renderer covers in its entity's space, to skip it for cameras that
+    // don't see it. Without bounds it renders for every camera.
+    virtual optional<Rect4f> local_bounds( const RenderSnapshot& snapshot ) const;
+
+    // Queues into the RenderEngine's SpriteBatch instead of drawing. The scene
+    // flushes the batch before every renderer that draws on its own.
+    virtual bool batches_sprites() const;
+
+    // See RenderQueue::sort_key(), from layer, priority and material
+    uint64  sort_key( const WorldTransforms& transforms ) const;
+
+    // Set by the scene, mark_bounds_changed() queues index into dirty. nullptr to stop.
+    void    track_bounds( std::vector<uint32>* dirty, uint32 index );
 
 protected:
+    // For changes of local_bounds() that don't come with the snapshot, e.g. a
+    // new size. The scene only places renderers again that moved or called this.
+    void    mark_bounds_changed();
+
     virtual void on_init( RenderEngine& ) = 0;
     virtual void on_render( RenderEngine&, Camera&, Matrix4f&, float ) = 0;
     virtual void on_cleanup( RenderEngine& ) = 0;
@@ -54,6 +83,9 @@ private:
     Entity    _entity;
 
     int       _renderlayer;
+
+    std::vector<uint32>*  _boundsDirty;
+    uint32                _boundsIndex;
 };
 
 ENGINE_NAMESPACE_END
@@ -0,0 +1,115 @@
+#include "stdafx.h"
+#include "renderqueue.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                     Public Static                      */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+uint64 RenderQueue::sort_key( int32 layer, float depth, uint32 shader, uint32 texture )
+{
+    // 1# Signed layer to unsigned, clamped to 16 bit
+    int32 clamped = std::min( std::max( layer, -32768 ), 32767 );
+    uint64 layerBits = (uint64)(clamped + 32768);
+
+    // 2# Float bits to unsigned with the same order: negatives flip, positives get the sign bit
+    uint32 bits;
+    std::memcpy( &bits, &depth, sizeof( bits ) );
+    uint64 depthBits = (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+
+    return (layerBits << 48) | (depthBits << 16) | ((uint64)(shader & 0xFF) << 8) | (uint64)(texture & 0xFF);
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Public                         */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+RenderQueue::RenderQueue() : _reused( false )
+{
+}
+
+void RenderQueue::clear()
+{
+    _keys.clear();
+    _items.clear();
+}
+
+void RenderQueue::submit( uint64 key, uint32 item )
+{
+    _keys.push_back( key );
+    _items.push_back( item );
+}
+
+const std::vector<uint32>& RenderQueue::sort()
+{
+    _reused = previous_order_sorted();
+    if ( !_reused ) radix_sort();
+
+    _sorted.resize( _order.size() );
+    for ( size_t i = 0; i < _order.size(); ++i )
+        _sorted[i] = _items[_order[i]];
+
+    return _sorted;
+}
+
+size_t RenderQueue::size() const
+{
+    return _keys.size();
+}
+
+bool RenderQueue::reused_order() const
+{
+    return _reused;
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Private                        */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+bool RenderQueue::previous_order_sorted() const
+{
+    Guard( _order.size() == _keys.size() ) return false;
+
+    // Same result as a stable sort: keys ascending, equal keys in submission order
+    for ( size_t i = 1; i < _order.size(); ++i ) {
+        uint64 k0 = _keys[_order[i - 1]];
+        uint64 k1 = _keys[_order[i]];
+
+        if ( k0 > k1 || (k0 == k1 && _order[i - 1] > _order[i]) ) return false;
+    }
+
+    return true;
+}
+
+void RenderQueue::radix_sort()
+{
+    size_t n = _keys.size();
+
+    _order.resize( n );
+    _scratch.resize( n );
+    for ( uint32 i = 0; i < n; ++i ) _order[i] = i;
+
+    Guard( n > 0 ) return;
+
+    // LSD, 8 bits per pass. Stable, so equal keys stay in submission order.
+    for ( uint32 shift = 0; shift < 64; shift += 8 ) {
+        size_t counts[256] = {};
+        for ( uint32 i : _order ) ++counts[(_keys[i] >> shift) & 0xFF];
+
+        // All keys share this byte, e.g. a single layer, nothing to reorder
+        if ( counts[(_keys[_order[0]] >> shift) & 0xFF] == n ) continue;
+
+        size_t offset = 0;
+        for ( size_t& count : counts ) {
+            size_t c = count;
+            count = offset;
+            offset += c;
+        }
+
+        for ( uint32 i : _order ) _scratch[counts[(_keys[i] >> shift) & 0xFF]++] = i;
+        _order.swap( _scratch );
+    }
+}
+
+ENGINE_NAMESPACE_END
@@ -0,0 +1,69 @@
+#pragma once
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                        Includes                        */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+// Std-Includes
+#include <vector>
+#include <algorithm>
+#include <cstring>
+
+// Other Includes
+
+// Internal Includes
+#include "_global.h"
+#include "noncopyable.h"
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Class                          */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+ENGINE_NAMESPACE_BEGIN
+
+// Orders draw items by a 64-bit key once per frame.
+//
+// Items are submitted with their key, sort() returns them ordered by key
+// and in submission order for equal keys. Keys are radix sorted, so a
+// frame costs a few linear passes and no comparisons. If the items come
+// in the same count as last frame and last frame's order is still sorted
+// under the new keys, that order is reused after a single check.
+//
+//    queue.clear();
+//    queue.submit( RenderQueue::sort_key( layer, depth, shader, texture ), i );   // per item
+//    for ( uint32 i : queue.sort() ) ...
+class RenderQueue : public noncopyable
+{
+public:
+    // layer (16 bit) | depth (32 bit) | shader (8 bit) | texture (8 bit), so items
+    // are in depth order per layer and equal depths group by state
+    static uint64 sort_key( int32 layer, float depth, uint32 shader, uint32 texture );
+
+                                RenderQueue();
+                                ~RenderQueue() = default;
+
+    void                        clear();
+    void                        submit( uint64 key, uint32 item );
+
+    const std::vector<uint32>&  sort();
+
+    size_t                      size() const;
+
+    // If the last sort() could keep the previous order
+    bool                        reused_order() const;
+
+private:
+    bool    previous_order_sorted() const;
+    void    radix_sort();
+
+    std::vector<uint64> _keys;
+    std::vector<uint32> _items;
+
+    // Submission positions in key order, kept for the next frame
+    std::vector<uint32> _order;
+    std::vector<uint32> _scratch;
+
+    std::vector<uint32> _sorted;
+    bool                _reused;
+};
+
+ENGINE_NAMESPACE_END
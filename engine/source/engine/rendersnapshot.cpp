@@ -0,0 +1,152 @@
+#include "stdafx.h"
+#include "rendersnapshot.h"
+
+#include "transform.h"
+#include "controllable.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Public                         */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+RenderSnapshot::RenderSnapshot()
+    : _tick( 0 ), _publishedNs( 0 )
+{
+}
+
+void RenderSnapshot::capture( tick_t tick, uint64 publishedNs )
+{
+    // 0# What moved since this snapshot was captured last, O(changes)
+    const PoolChanges& moved = CTransform::get_changes();
+
+    if ( moved.covers( _tick ) )
+        moved.each_since( _tick, [&]( entity_id id ) { _boundsChanges.push( id ); } );
+    else
+        _boundsChanges.clear();
+
+    _tick        = tick;
+    _publishedNs = publishedNs;
+
+    // 1# Transforms
+    auto& transforms = CTransform::get_all_components();
+    _transforms.clear();
+    _transforms.reserve( transforms.size() );
+
+    for ( size_t i = 0; i < transforms.size(); ++i ) {
+        const CTransform& t = transforms.values()[i];
+        _transforms.put( transforms.keys()[i], {
+            t.last_position(), t.position(),
+            t.last_scale(),    t.scale(),
+            t.last_rotation(), t.rotation()
+        } );
+    }
+
+    // 2# Motion, drives sprite animations
+    auto& controllables = CControllable::get_all_components();
+    _motions.clear();
+
+    for ( size_t i = 0; i < controllables.size(); ++i ) {
+        const CControllable& c = controllables.values()[i];
+        _motions.put( controllables.keys()[i], { c.moveUp, c.moveDown, c.moveLeft, c.moveRight } );
+    }
+
+    // 3# Tilemaps, few but heavy, so entries are updated in place instead of refilled
+    auto& tilemaps = CTilemapLogic::get_all_components();
+
+    std::vector<entity_id> gone;
+    for ( entity_id id : _tilemaps.keys() )
+        if ( !tilemaps.contains( id ) )
+            gone.push_back( id );
+
+    for ( entity_id id : gone ) {
+        _tilemaps.remove( id );
+        _boundsChanges.push( id );
+    }
+
+    for ( size_t i = 0; i < tilemaps.size(); ++i ) {
+        const CTilemapLogic& logic = tilemaps.values()[i];
+
+        Tilemap* entry = _tilemaps.try_access( tilemaps.keys()[i] );
+        if ( entry != nullptr && entry->changedTick == logic.changed_tick() )
+            continue;
+
+        if ( entry == nullptr )
+            entry = &_tilemaps.put( tilemaps.keys()[i], Tilemap() );
+
+        capture_tilemap( logic, *entry );
+    }
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Private                        */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+void RenderSnapshot::capture_tilemap( const CTilemapLogic& logic, Tilemap& entry )
+{
+    bool sameShape = entry.width == logic.width && entry.height == logic.height
+                  && entry.tiles.size() == logic.tiles.size();
+
+    // 1# Only the edits since this slot last held the map, O(edits). Stamped
+    //    with this tick, so a consumer may see an edit twice but never miss one.
+    if ( sameShape && logic.edits.covers( entry.changedTick ) ) {
+        logic.edits.each_since( entry.changedTick, [&]( const TileEdit& edit ) {
+            uint32 index = edit.y * logic.width + edit.x;
+            entry.tiles[index] = logic.tiles[index];
+            entry.edits.push( edit );
+        } );
+    }
+    // 2# Reshaped, or away longer than the edit history: full copy, consumers resync
+    else {
+        entry.width  = logic.width;
+        entry.height = logic.height;
+        entry.tiles  = logic.tiles;
+        entry.edits.clear();
+        _boundsChanges.push( logic.entity.id() );
+    }
+
+    entry.changedTick = logic.changed_tick();
+}
+
+tick_t RenderSnapshot::tick() const
+{
+    return _tick;
+}
+
+uint64 RenderSnapshot::published_ns() const
+{
+    return _publishedNs;
+}
+
+const RenderSnapshot::Transform* RenderSnapshot::find_transform( Entity entity ) const
+{
+    return _transforms.try_access( entity.id() );
+}
+
+const std::vector<RenderSnapshot::Transform>& RenderSnapshot::transforms() const
+{
+    return _transforms.values();
+}
+
+uint32 RenderSnapshot::transform_index( Entity entity ) const
+{
+    const Transform* transform = find_transform( entity );
+    return transform != nullptr ? (uint32)(transform - _transforms.values().data()) : NO_INDEX;
+}
+
+const RenderSnapshot::Motion* RenderSnapshot::find_motion( Entity entity ) const
+{
+    return _motions.try_access( entity.id() );
+}
+
+const RenderSnapshot::Tilemap* RenderSnapshot::find_tilemap( Entity entity ) const
+{
+    return _tilemaps.try_access( entity.id() );
+}
+
+const RenderSnapshot::BoundsChanges& RenderSnapshot::bounds_changes() const
+{
+    return _boundsChanges;
+}
+
+ENGINE_NAMESPACE_END
@@ -0,0 +1,94 @@
+#pragma once
+
+// Std-Includes
+
+// Other Includes
+
+// Internal Includes
+#include "_global.h"
+#include "compact_map.h"
+#include "vector3f.h"
+#include "quaternion4f.h"
+#include "component.h"
+#include "changelog.h"
+#include "tilemaplogic.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+// Everything the renderers need from one logic tick, copied out of the
+// component pools at the end of the tick. The render thread only ever
+// reads snapshots, it never touches live components.
+//
+// Transforms carry the previous tick as well, so a single snapshot is
+// enough to interpolate between the last two ticks.
+class RenderSnapshot
+{
+public:
+    static const uint32 NO_INDEX = 0xFFFFFFFF;
+
+    struct Transform {
+        Vector3f        lastPosition;
+        Vector3f        position;
+        Vector3f        lastScale;
+        Vector3f        scale;
+        Quaternion4f    lastRotation;
+        Quaternion4f    rotation;
+    };
+
+    struct Motion {
+        bool moveUp;
+        bool moveDown;
+        bool moveLeft;
+        bool moveRight;
+    };
+
+    // Only touched when the tilemap changed since this snapshot last held it,
+    // then patched with the edits since, the whole map is only copied on a
+    // reshape. edits are this snapshot's own, stamped when they were captured.
+    struct Tilemap {
+        uint32              width;
+        uint32              height;
+        tick_t              changedTick;
+
+        std::vector<uint32> tiles;
+        ChangeLog<TileEdit> edits;
+    };
+
+    // Entities whose transform changed or whose tilemap was reshaped or
+    // removed, stamped with the capture that saw it. Covers the changes since
+    // this snapshot's previous capture, so a consumer a few snapshots behind
+    // still gets all of them. Short, it gets every moving entity each tick.
+    typedef ChangeLog<entity_id, 8> BoundsChanges;
+
+            RenderSnapshot();
+
+    // Refills this snapshot from the component pools, logic thread only
+    void    capture( tick_t tick, uint64 publishedNs );
+
+    tick_t  tick() const;
+    uint64  published_ns() const;
+
+    const Transform*    find_transform( Entity entity ) const;
+
+    // All transforms, contiguous. transform_index() is the entity's position in here.
+    const std::vector<Transform>&   transforms() const;
+    uint32                          transform_index( Entity entity ) const;
+    const Motion*       find_motion( Entity entity ) const;
+    const Tilemap*      find_tilemap( Entity entity ) const;
+
+    const BoundsChanges&    bounds_changes() const;
+
+private:
+    void    capture_tilemap( const CTilemapLogic& logic, Tilemap& entry );
+
+    tick_t                              _tick;
+    uint64                              _publishedNs;
+
+    compact_map<entity_id, Transform>   _transforms;
+    compact_map<entity_id, Motion>      _motions;
+    compact_map<entity_id, Tilemap>     _tilemaps;
+
+    BoundsChanges                       _boundsChanges;
+};
+
+ENGINE_NAMESPACE_END
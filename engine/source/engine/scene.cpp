@@ -3,6 +3,10 @@
 
 ENGINE_NAMESPACE_BEGIN
 
+Scene::Scene() : _grid( CULL_CELL_SIZE ), _boundsTick( 0 ), _boundsStale( true )
+{
+}
+
 owner<Camera> Scene::remove_camera( weak<Camera> cam )
 {
     return extract_owner( _cameras, cam );
@@ -13,6 +17,10 @@ owner<Renderer> Scene::remove_renderer( weak<Renderer> renderer )
     if ( contains_owner( _ownerRenderers, renderer ) ) {
         _renderers.erase( std::remove( _renderers.begin(), _renderers.end(), renderer ) );
         _uninitRenderers.erase( std::remove( _uninitRenderers.begin(), _uninitRenderers.end(), renderer ) );
+
+        // Indices after it shifted, the next frame places everything again
+        renderer->track_bounds( nullptr, 0 );
+        _boundsStale = true;
         return extract_owner( _ownerRenderers, renderer );
     }
 
@@ -29,16 +37,36 @@ void Scene::cleanup( RenderEngine& engine )
 void Scene::render( RenderEngine& engine, float delta )
 {
     initialize_renderers( engine );
-    sort_renderers();
+    update_bounds( engine );
 
-    for ( auto& camera : _cameras ) {
+    while ( _queues.size() < _cameras.size() ) {
+        _queues.push_back( make_owner<RenderQueue>() );
+    }
+
+    for ( size_t i = 0; i < _cameras.size(); ++i ) {
+        Camera& camera = *_cameras[i];
         glClear( GL_DEPTH_BUFFER_BIT );
 
-        camera->activate( delta );
-        Matrix4f projViewMat4 = camera->proj_view_mat4();
-        for ( weak<Renderer> renderer : _renderers ) {
-            renderer->render( engine, *camera, projViewMat4, delta );
+        camera.activate( delta );
+        engine.get_camera_uniforms().update( camera );
+
+        // After activate(), the view follows the camera target
+        const std::vector<uint32>& order = sort_renderers( camera, engine.get_world_transforms(), *_queues[i] );
+
+        // Sprites only queue themselves, whatever they queued draws before
+        // the next renderer that draws on its own, to keep the sorted order
+        SpriteBatch& batch = engine.get_sprite_batch();
+        Matrix4f projViewMat4 = camera.proj_view_mat4();
+
+        for ( uint32 index : order ) {
+            Renderer& renderer = *_renderers[index];
+            if ( !renderer.batches_sprites() )
+                batch.flush();
+
+            renderer.render( engine, camera, projViewMat4, delta );
         }
+
+        batch.flush();
     }
 }
 
@@ -53,19 +81,129 @@ void Scene::initialize_renderers( RenderEngine& engine ) {
     }
 }
 
-void Scene::sort_renderers() {
-    std::sort( _renderers.begin(), _renderers.end(), priority_less() );
+void Scene::update_bounds( RenderEngine& engine ) {
+    const RenderSnapshot&                 snapshot   = engine.get_snapshot();
+    const WorldTransforms&                transforms = engine.get_world_transforms();
+    const RenderSnapshot::BoundsChanges&  changes    = snapshot.bounds_changes();
+
+    // Transforms written in the snapshot's own tick still interpolate, so
+    // their renderers are placed again every frame until the next snapshot
+    tick_t since = std::min( _boundsTick, snapshot.tick() > 0 ? snapshot.tick() - 1 : 0 );
+    _boundsTick = snapshot.tick();
+
+    // 1# Everything, if indices or entities changed or the changes don't reach back
+    bool stale = _boundsStale || !changes.covers( since );
+    for ( uint32 i : _boundsDirty ) {
+        stale = stale || ( i < _boundsEntities.size() && _boundsEntities[i] != _renderers[i]->get_entity().id() );
+    }
+
+    if ( stale ) {
+        update_all_bounds( snapshot, transforms );
+        return;
+    }
+
+    // 2# Renderers added since, they are appended
+    for ( uint32 i = (uint32)_boundsEntities.size(); i < _renderers.size(); ++i ) {
+        track_bounds( i );
+        place_bounds( snapshot, transforms, i );
+    }
+
+    // 3# Renderers with new local bounds, then the ones of entities that moved
+    for ( uint32 i : _boundsDirty ) {
+        place_bounds( snapshot, transforms, i );
+    }
+
+    _boundsDirty.clear();
+
+    changes.each_since( since, [&]( entity_id id ) {
+        auto indices = _renderersOf.find( id );
+        Guard( indices != _renderersOf.end() ) return;
+
+        for ( uint32 i : indices->second ) {
+            place_bounds( snapshot, transforms, i );
+        }
+    } );
 }
 
-bool priority_less::operator()( const weak<Renderer>& r0, const weak<Renderer>& r1 )
-{
-    if ( r0->render_layer() == r1->render_layer() ) {
-        return (r0->render_layer_priority() < r1->render_layer_priority());
-    } 
-    else
-        return (r0->render_layer() < r1->render_layer()); // Can't be null, since we own the renderers
+void Scene::update_all_bounds( const RenderSnapshot& snapshot, const WorldTransforms& transforms ) {
+    _grid.clear();
+    _unbounded.clear();
+    _boundsEntities.clear();
+    _renderersOf.clear();
+    _boundsDirty.clear();
+
+    for ( uint32 i = 0; i < _renderers.size(); ++i ) {
+        track_bounds( i );
+        place_bounds( snapshot, transforms, i );
+    }
+
+    _boundsStale = false;
+}
+
+void Scene::place_bounds( const RenderSnapshot& snapshot, const WorldTransforms& transforms, uint32 index ) {
+    const Renderer& renderer = *_renderers[index];
+    optional<Rect4f> local = renderer.local_bounds( snapshot );
+
+    // _unbounded stays sorted, there are only a few
+    auto unbounded = std::lower_bound( _unbounded.begin(), _unbounded.end(), index );
+    bool listed    = unbounded != _unbounded.end() && *unbounded == index;
+
+    if ( !local ) {
+        _grid.remove( index );
+        if ( !listed )
+            _unbounded.insert( unbounded, index );
+        return;
+    }
+
+    if ( listed )
+        _unbounded.erase( unbounded );
+
+    // Only relinks in the grid when the center crossed into another cell
+    const Affine2D& world = transforms.world( transforms.index_of( renderer.get_entity() ) );
+    _grid.update( index, world.transform( *local ) );
+}
+
+void Scene::track_bounds( uint32 index ) {
+    Requires( index == _boundsEntities.size() );
+
+    Renderer& renderer = *_renderers[index];
+    entity_id id = renderer.get_entity().id();
+
+    renderer.track_bounds( &_boundsDirty, index );
+    _boundsEntities.push_back( id );
+
+    _renderersOf[id].push_back( index );
+}
+
+const std::vector<uint32>& Scene::sort_renderers( const Camera& camera, const WorldTransforms& transforms, RenderQueue& queue ) {
+    queue.clear();
+
+    optional<Rect4f> view = camera.view_rect();
+    if ( !view ) {
+        for ( uint32 i = 0; i < _renderers.size(); ++i ) {
+            queue.submit( _renderers[i]->sort_key( transforms ), i );
+        }
+
+        return queue.sort();
+    }
+
+    // One key per visible renderer, submitted by index so an unchanged view can reuse the last order
+    _visible.clear();
+    _grid.query( *view, _visible );
+    _visible.insert( _visible.end(), _unbounded.begin(), _unbounded.end() );
+    std::sort( _visible.begin(), _visible.end() );
+
+    for ( uint32 i : _visible ) {
+        queue.submit( _renderers[i]->sort_key( transforms ), i );
+    }
+
+    return queue.sort();
 }
 
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                      Private Static                    */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
+const float Scene::CULL_CELL_SIZE = 8.0f;
 
 ENGINE_NAMESPACE_END
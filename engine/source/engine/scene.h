@@ -5,6 +5,7 @@
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
 // Std-Includes
+#include <unordered_map>
 
 // Other Includes
 
@@ -14,6 +15,8 @@
 #include "camera.h"
 
 #include "renderer.h"
+#include "renderqueue.h"
+#include "loosegrid.h"
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 /*                         Class                          */
@@ -22,16 +25,14 @@ ENGINE_NAMESPACE_BEGIN
 
 class Renderer;
 class RenderEngine;
-
-class priority_less
-{
-public:
-    bool operator() ( const weak<Renderer>& r0, const weak<Renderer>& r1 );
-};
+class RenderSnapshot;
+class WorldTransforms;
 
 class Scene : public noncopyable
 {
 public:
+                      Scene();
+
     template<typename T>
     weak<T>           add_camera();
     template<typename T>
@@ -54,9 +55,27 @@ public:
     void              cleanup( RenderEngine& );
 
 private:
+    // Edge of a culling grid cell in world units, about a sprite or a screen part wide
+    static const float CULL_CELL_SIZE;
+
     void    initialize_renderers( RenderEngine& engine );
     void    cleanup_renderers();
-    void    sort_renderers();
+
+    // Keeps _grid and _unbounded up to date. Only renderers of entities in the
+    // snapshot's bounds changes and the ones that marked their bounds changed
+    // are placed again, everything only on the first frame, after a removal,
+    // or when the snapshot's history doesn't reach back to the last frame.
+    void    update_bounds( RenderEngine& engine );
+    void    update_all_bounds( const RenderSnapshot& snapshot, const WorldTransforms& transforms );
+
+    // Places one renderer's world bounds in _grid, or in _unbounded
+    void    place_bounds( const RenderSnapshot& snapshot, const WorldTransforms& transforms, uint32 index );
+
+    // Appends _renderers[index] to the lookups by entity, indices have to come in order
+    void    track_bounds( uint32 index );
+
+    // Indices into _renderers the camera sees, in draw order
+    const std::vector<uint32>& sort_renderers( const Camera& camera, const WorldTransforms& transforms, RenderQueue& queue );
 
     std::vector<owner<Camera>>    _cameras;
 
@@ -64,6 +83,26 @@ private:
     std::vector<weak<Renderer>>     _uninitRenderers;
     std::vector<weak<Renderer>>     _renderers;
 
+    // Bounded renderers by index into _renderers, the rest draws for every camera
+    LooseGrid                       _grid;
+    std::vector<uint32>             _unbounded;
+    std::vector<uint32>             _visible;
+
+    // Snapshot tick the bounds are placed for, the next frame places what changed since
+    tick_t                          _boundsTick;
+    bool                            _boundsStale;
+
+    // Per renderer index its entity, and the other way round. Not a
+    // compact_map, renderers may outlive their entity and its index be reused.
+    std::vector<entity_id>                                  _boundsEntities;
+    std::unordered_map<entity_id, std::vector<uint32>>      _renderersOf;
+
+    // Renderer indices from Renderer::mark_bounds_changed(), may repeat
+    std::vector<uint32>             _boundsDirty;
+
+    // One per camera, so each keeps its own last order to reuse
+    std::vector<owner<RenderQueue>> _queues;
+
 };
 
 template<typename T>
@@ -28,6 +28,17 @@ Uniform Shader::frag_uniform(string varname )
     return _fragUniforms[varname];
 }
 
+Uniform::Handle Shader::uniform_handle( const Uniform& uniform ) const
+{
+    auto it = _vertexUniforms.find( uniform.gl_varname() );
+    if ( it != _vertexUniforms.end() ) return it->second.gl_location();
+
+    it = _fragUniforms.find( uniform.gl_varname() );
+    if ( it != _fragUniforms.end() ) return it->second.gl_location();
+
+    return Uniform::INVALID_HANDLE;
+}
+
 nullable<TextureSlot> Shader::frag_texture_slot(string name) 
 {
     for (auto slot : _fragTextureSlots) {
@@ -44,6 +55,11 @@ VertexLayout Shader::get_vertex_layout()
     return _vertexLayout;
 }
 
+GLuint Shader::id() const
+{
+    return _id;
+}
+
 Shader::Shader( VertexLayout pLayout, std::vector<Uniform> pVUniforms, std::vector<Uniform> pFUniforms, 
                 std::vector<TextureSlot> pTexSlots, string pVertexCode, string pFragCode )
 {
@@ -55,6 +71,12 @@ Shader::Shader( VertexLayout pLayout, std::vector<Uniform> pVUniforms, std::vect
 
     _id = link_shader( vShaderId, fShaderId );
 
+    // Camera data comes from the shared uniform buffer
+    GLuint cameraBlock = glGetUniformBlockIndex( _id, CameraUniforms::BLOCK_NAME );
+    if ( cameraBlock != GL_INVALID_INDEX ) {
+        glUniformBlockBinding( _id, cameraBlock, CameraUniforms::BINDING );
+    }
+
     _vertexUniforms = process_uniforms( pVUniforms );
     _fragUniforms   = process_uniforms( pFUniforms );
     _fragTextureSlots = process_textureslots( pTexSlots );
@@ -67,6 +89,7 @@ Shader::~Shader()
 {
     LOGGER.log(Level::DEBUG, _id) << "DELETE\n";
     glDeleteProgram( _id );
+    GLStateCache::instance().forget_program( _id );
     PerfStats::instance().frame_unload_shader();
 }
 
@@ -81,6 +104,7 @@ GLuint Shader::create_vertex_shader( VertexLayout pLayout, std::vector<Uniform>
         << "\n";
 
     // Uniforms
+    vertexCode << CameraUniforms::glsl();
     for ( Uniform uniform : pVUniforms ) {
         vertexCode << UNIFORM( uniform );
     }
@@ -193,8 +217,10 @@ std::vector<TextureSlot> Shader::process_textureslots( std::vector<TextureSlot>
 {
     bind();
 
-    for ( TextureSlot slot : pSlots ) {
+    // Samplers never change their unit, set them here instead of per bind
+    for ( TextureSlot& slot : pSlots ) {
         slot.location = glGetUniformLocation( _id, slot.name.c_str() );
+        glUniform1i( slot.location, slot.slot );
     }
 
     return pSlots;
@@ -204,8 +230,6 @@ std::vector<TextureSlot> Shader::process_textureslots( std::vector<TextureSlot>
 /*                      Private Static                    */
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
-GLuint Shader::CURRENT_SHADER = 0;
-
 Logger Shader::LOGGER = Logger("Shader", Level::DEBUG);
 
 string Shader::VERTEX_COMPONENT( VertexComponent vComp )
@@ -25,6 +25,8 @@
 #include "vector3f.h"
 #include "vector4f.h"
 #include "matrix4f.h"
+#include "affine2d.h"
+#include "camerauniforms.h"
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 /*                         Class                          */
@@ -52,16 +54,17 @@ public:
     Uniform                 frag_uniform( string name );
     nullable<TextureSlot>   frag_texture_slot( string name );
     VertexLayout            get_vertex_layout();
+    GLuint                  id() const;
 
-    void                    set_vertex_uniform( Uniform uniform, const Matrix4f& mat4 );
-    void                    set_vertex_uniform( Uniform uniform, const Vector2f& vec2 );
-    void                    set_vertex_uniform( Uniform uniform, const Vector3f& vec3 );
-    void                    set_vertex_uniform( Uniform uniform, const Vector4f& vec4 );
+    // Resolves a declared uniform once, at setup. Draws then only pass the handle around.
+    Uniform::Handle         uniform_handle( const Uniform& uniform ) const;
 
-    void                    set_frag_uniform( Uniform uniform, const Matrix4f& mat4 );
-    void                    set_frag_uniform( Uniform uniform, const Vector2f& vec2 );
-    void                    set_frag_uniform( Uniform uniform, const Vector3f& vec3 );
-    void                    set_frag_uniform( Uniform uniform, const Vector4f& vec4 );
+    void                    set_uniform( Uniform::Handle handle, const Matrix4f& mat4 );
+    void                    set_uniform( Uniform::Handle handle, const Affine2D& affine );
+    void                    set_uniform( Uniform::Handle handle, float value );
+    void                    set_uniform( Uniform::Handle handle, const Vector2f& vec2 );
+    void                    set_uniform( Uniform::Handle handle, const Vector3f& vec3 );
+    void                    set_uniform( Uniform::Handle handle, const Vector4f& vec4 );
 
 private:
     /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
@@ -74,11 +77,6 @@ private:
             map<string, Uniform>      _fragUniforms;
             std::vector<TextureSlot>  _fragTextureSlots;
 
-    void    set_uniform( Uniform uniform, const Matrix4f& mat4, std::map<string, Uniform>& uniforms );
-    void    set_uniform( Uniform uniform, const Vector2f& vec2, std::map<string, Uniform>& uniforms );
-    void    set_uniform( Uniform uniform, const Vector3f& vec3, std::map<string, Uniform>& uniforms );
-    void    set_uniform( Uniform uniform, const Vector4f& vec4, std::map<string, Uniform>& uniforms );
-
     GLuint  create_vertex_shader( VertexLayout pLayout, std::vector<Uniform> pVUniforms, string pVertexSrc );
     GLuint  create_frag_shader( VertexLayout pLayout, std::vector<Uniform> pFUniforms, std::vector<TextureSlot> pTexSlots, string pFragSrc );
     GLuint  link_shader( GLuint pVShaderId, GLuint pFShaderId );
@@ -89,7 +87,6 @@ private:
     /*                     Private Static                     */
     /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
-    static GLuint CURRENT_SHADER;
     static Logger LOGGER;
 
     static string VERTEX_COMPONENT( VertexComponent vComp );
@@ -101,82 +98,43 @@ private:
 
 inline void Shader::bind()
 {
-    if ( CURRENT_SHADER != _id ) {
-        glUseProgram( _id );
-        CURRENT_SHADER = _id;
-    }
-}
-
-inline void Shader::set_vertex_uniform( Uniform uniform, const Matrix4f & mat4 ) 
-{ 
-    set_uniform( uniform, mat4, _vertexUniforms ); 
-}
-
-inline void Shader::set_vertex_uniform( Uniform uniform, const Vector2f& vec2 ) 
-{ 
-    set_uniform( uniform, vec2, _vertexUniforms ); 
+    GLStateCache::instance().use_program( _id );
 }
 
-inline void Shader::set_vertex_uniform( Uniform uniform, const Vector3f& vec3 ) 
-{ 
-    set_uniform( uniform, vec3, _vertexUniforms ); 
-}
-
-inline void Shader::set_vertex_uniform( Uniform uniform, const Vector4f& vec4 ) 
-{ 
-    set_uniform( uniform, vec4, _vertexUniforms ); 
-}
-
-inline void Shader::set_frag_uniform( Uniform uniform, const Matrix4f& mat4 ) 
+inline void Shader::set_uniform( Uniform::Handle handle, const Matrix4f& mat4 )
 {
-    set_uniform( uniform, mat4, _fragUniforms ); 
-}
-
-inline void Shader::set_frag_uniform( Uniform uniform, const Vector2f& vec2 ) 
-{ 
-    set_uniform( uniform, vec2, _fragUniforms ); 
-}
-
-inline void Shader::set_frag_uniform( Uniform uniform, const Vector3f& vec3 ) 
-{ 
-    set_uniform( uniform, vec3, _fragUniforms ); 
+    bind();
+    glUniformMatrix4fv( handle, 1, false, mat4.data() );
 }
 
-inline void Shader::set_frag_uniform( Uniform uniform, const Vector4f& vec4 ) 
+inline void Shader::set_uniform( Uniform::Handle handle, const Affine2D& affine )
 {
-    set_uniform( uniform, vec4, _fragUniforms ); 
+    bind();
+    glUniformMatrix2x3fv( handle, 1, false, affine.data() );
 }
 
-inline void Shader::set_uniform( Uniform uniform, const Matrix4f& mat4, map<string, Uniform>& uniforms ) {
-#ifdef MAT4_ROW_MAJOR
-    std::vector<float> matrix = mat4.row_major();
-    bool transpose = true;
-#else
-    std::vector<float> matrix = mat4.column_major();
-    bool transpose = false;
-#endif
-
-    uint32        location = uniforms.find( uniform.gl_varname() )->second.gl_location();
+inline void Shader::set_uniform( Uniform::Handle handle, float value )
+{
     bind();
-    glUniformMatrix4fv( location, 1, transpose, matrix.data() );
+    glUniform1f( handle, value );
 }
 
-inline void Shader::set_uniform( Uniform uniform, const Vector2f& vec2, map<string, Uniform>& uniforms ) {
-    uint32        location = uniforms.find( uniform.gl_varname() )->second.gl_location();
+inline void Shader::set_uniform( Uniform::Handle handle, const Vector2f& vec2 )
+{
     bind();
-    glUniform2f( location, vec2.x, vec2.y );
+    glUniform2f( handle, vec2.x, vec2.y );
 }
 
-inline void Shader::set_uniform( Uniform uniform, const Vector3f& vec3, map<string, Uniform>& uniforms ) {
-    uint32        location = uniforms.find( uniform.gl_varname() )->second.gl_location();
+inline void Shader::set_uniform( Uniform::Handle handle, const Vector3f& vec3 )
+{
     bind();
-    glUniform3f( location, vec3.x, vec3.y, vec3.z );
+    glUniform3f( handle, vec3.x, vec3.y, vec3.z );
 }
 
-inline void Shader::set_uniform( Uniform uniform, const Vector4f& vec4, map<string, Uniform>& uniforms ) {
-    uint32        location = uniforms.find( uniform.gl_varname() )->second.gl_location();
+inline void Shader::set_uniform( Uniform::Handle handle, const Vector4f& vec4 )
+{
     bind();
-    glUniform4f( location, vec4.x, vec4.y, vec4.z, vec4.w );
+    glUniform4f( handle, vec4.x, vec4.y, vec4.z, vec4.w );
 }
 
 ENGINE_NAMESPACE_END
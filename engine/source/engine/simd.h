@@ -0,0 +1,70 @@
+#pragma once
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                        Includes                        */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+// Std-Includes
+#include <emmintrin.h>
+
+// Other Includes
+
+// Internal Includes
+#include "_global.h"
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                        Functions                       */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+ENGINE_NAMESPACE_BEGIN
+
+// SSE2 helpers for the math types. SSE2 is part of both the x86 and the
+// x64 baseline the engine builds for, so there is no scalar fallback.
+// AVX would need /arch:AVX, which the project doesn't set.
+namespace simd {
+
+// Lanes of v as (v[x], v[y], v[z], v[w])
+#define SIMD_SWIZZLE( v, x, y, z, w )     _mm_shuffle_ps( (v), (v), _MM_SHUFFLE( w, z, y, x ) )
+
+// (a[x], a[y], b[z], b[w])
+#define SIMD_SHUFFLE( a, b, x, y, z, w )  _mm_shuffle_ps( (a), (b), _MM_SHUFFLE( w, z, y, x ) )
+
+#define SIMD_SPLAT( v, i )                SIMD_SWIZZLE( v, i, i, i, i )
+
+// Sum of all lanes in every lane
+inline __m128 sum4( __m128 v )
+{
+    v = _mm_add_ps( v, SIMD_SWIZZLE( v, 2, 3, 0, 1 ) );
+    return _mm_add_ps( v, SIMD_SWIZZLE( v, 1, 0, 3, 2 ) );
+}
+
+// Dot product in every lane
+inline __m128 dot4( __m128 a, __m128 b )
+{
+    return sum4( _mm_mul_ps( a, b ) );
+}
+
+// Flips the sign of the lanes set to -0.f in mask
+inline __m128 negate( __m128 v, __m128 mask )
+{
+    return _mm_xor_ps( v, mask );
+}
+
+// x, y, z from memory, w = 0. Vector3f is 12 bytes and packed into vertex layouts,
+// so it can't be loaded as a whole.
+inline __m128 load3( const float* p )
+{
+    return _mm_setr_ps( p[0], p[1], p[2], 0.0f );
+}
+
+inline void store3( float* p, __m128 v )
+{
+    alignas(16) float tmp[4];
+    _mm_store_ps( tmp, v );
+    p[0] = tmp[0];
+    p[1] = tmp[1];
+    p[2] = tmp[2];
+}
+
+}
+
+ENGINE_NAMESPACE_END
@@ -77,11 +77,11 @@ void SimpleVertexArray<VERTEX>::native_create()
 {
     glGenVertexArrays( 1, &_id );
 
-    glBindVertexArray( _id );
+    GLStateCache::instance().bind_vertex_array( _id );
     for ( VertexComponent component : _layout.components() ) {
         glEnableVertexAttribArray( component.position );
     }
-    glBindVertexArray( 0 );
+    GLStateCache::instance().bind_vertex_array( 0 );
 }
 
 template<class VERTEX>
@@ -107,34 +107,34 @@ template<class VERTEX>
 void SimpleVertexArray<VERTEX>::native_delete()
 {
     glDeleteVertexArrays( 1, &_id );
+    GLStateCache::instance().forget_vertex_array( _id );
 }
 
 template<class VERTEX>
 void SimpleVertexArray<VERTEX>::native_bind()
 {
-    glBindVertexArray( _id );
+    GLStateCache::instance().bind_vertex_array( _id );
 }
 
 template<class VERTEX>
 void SimpleVertexArray<VERTEX>::native_unbind()
 {
-    glBindVertexArray( 0 );
+    GLStateCache::instance().bind_vertex_array( 0 );
 }
 
 template<class VERTEX>
 void SimpleVertexArray<VERTEX>::render_by_indexbuffer() {
-    glBindVertexArray( _id );
+    // Stays bound, the next draw of this array skips the bind
+    native_bind();
     glDrawElements( (GLuint)PrimitiveType::TRIANGLES, (GLsizei)_indexBuffer->size() , GL_UNSIGNED_INT, BUFFER_OFFSET( 0 ) );
-    glBindVertexArray( 0 );
 
     PerfStats::instance().frame_draw_call( _indexBuffer->size() );
 }
 
 template<class VERTEX>
 void SimpleVertexArray<VERTEX>::render_all() {
-    glBindVertexArray( _id );
+    native_bind();
     glDrawArrays( (GLuint)PrimitiveType::TRIANGLES, 0, (GLsizei)_vertexBuffer->size() );
-    glBindVertexArray( 0 );
 
     PerfStats::instance().frame_draw_call( _vertexBuffer->size() / 3 );
 }
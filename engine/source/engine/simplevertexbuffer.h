@@ -39,6 +39,7 @@ public:
                 ~SimpleVertexBuffer();
 
     std::vector<uint32>    add_vertices( std::vector<VERTEX> vertices );
+    void                   set_vertices( size_t first, std::vector<VERTEX> vertices );
     void                   clear();
     size_t                 size();
 
@@ -67,10 +68,8 @@ SimpleVertexBuffer<VERTEX>::SimpleVertexBuffer(VertexLayout layout) :
     _layout(layout), _nativeCapacity(0),
     _nativeEnd(0)
 {
+    // The layout is set by SimpleVertexArray with its VAO bound
     native_create( (GLuint)_nativeCapacity );
-    native_bind();
-    native_vbo_layout();
-    native_unbind();
 }
 
 template<class T>
@@ -93,10 +92,10 @@ std::vector<uint32> SimpleVertexBuffer<T>::add_vertices( std::vector<T> vertices
     // 2# Resize if necessary
     size_t requiredNativeCapacity = _nativeEnd + nativeData.size() * sizeof(float);
     if ( _nativeCapacity < requiredNativeCapacity ) {
-        size_t newNativeCapacity = _nativeCapacity + RESIZE_BUFFER_SIZE;
+        size_t newNativeCapacity = std::max( _nativeCapacity * 2, (size_t)RESIZE_BUFFER_SIZE );
 
         while ( newNativeCapacity < requiredNativeCapacity ) {
-            newNativeCapacity += RESIZE_BUFFER_SIZE;
+            newNativeCapacity *= 2;
         }
 
         native_resize( (GLuint)_nativeCapacity, (GLuint)newNativeCapacity );
@@ -117,6 +116,21 @@ std::vector<uint32> SimpleVertexBuffer<T>::add_vertices( std::vector<T> vertices
     return indices;
 }
 
+// Overwrites already added vertices in place, starting at vertex index first
+template<class VERTEX>
+void SimpleVertexBuffer<VERTEX>::set_vertices( size_t first, std::vector<VERTEX> vertices )
+{
+    Requires( first + vertices.size() <= size() );
+    if ( vertices.size() == 0 ) return;
+
+    std::vector<float> nativeData;
+    for ( auto vertex : vertices ) {
+        nativeData.insert( nativeData.end(), vertex.data.begin(), vertex.data.end() );
+    }
+
+    native_write_at( (GLuint)(first * _layout.bytesize()), nativeData );
+}
+
 template<class VERTEX>
 void SimpleVertexBuffer<VERTEX>::clear()
 {
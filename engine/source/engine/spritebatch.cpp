@@ -0,0 +1,83 @@
+#include "stdafx.h"
+#include "spritebatch.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Public                         */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+SpriteBatch::SpriteBatch( weak<StreamBuffer> stream ) : _stream( stream )
+{
+    _vao.get_vertex_buffer( Vertex_sprite::CORNER )->add( Vertex_sprite::unit_quad() );
+}
+
+void SpriteBatch::add( const Material& material, int32 layer, const Instance& instance )
+{
+    _entries.push_back( { layer, material.get_shader().get(), material.get_texture_diffuse().get(), &material, instance } );
+}
+
+void SpriteBatch::flush()
+{
+    Guard( !_entries.empty() ) return;
+
+    // 1# One upload per attribute for the whole pass, in the order sprites were added.
+    //    Not regrouped by state, that would draw blended sprites out of depth order.
+    _worlds0.clear();
+    _worlds1.clear();
+    _depths.clear();
+    _uvRects.clear();
+    _tints.clear();
+
+    for ( const Entry& entry : _entries ) {
+        const Affine2D& world = entry.instance.world;
+
+        write_into( _worlds0, Vector3f( world.m00, world.m01, world.m02 ) );
+        write_into( _worlds1, Vector3f( world.m10, world.m11, world.m12 ) );
+        _depths.push_back( entry.instance.depth );
+        write_into( _uvRects, entry.instance.uvRect );
+        write_into( _tints,   entry.instance.tint );
+    }
+
+    // Reserved together, so the ring can't orphan between two attributes and
+    // drop the ones already written. Each write pads to at most a vec4.
+    size_t floats = _worlds0.size() + _worlds1.size() + _depths.size() + _uvRects.size() + _tints.size();
+    _stream->reserve( floats * FLOAT_BYTES + 5 * VECTOR4F_BYTES );
+
+    _vao.stream( Vertex_sprite::WORLD0, *_stream, _worlds0.data(), _entries.size() );
+    _vao.stream( Vertex_sprite::WORLD1, *_stream, _worlds1.data(), _entries.size() );
+    _vao.stream( Vertex_sprite::DEPTH,  *_stream, _depths.data(),  _entries.size() );
+    _vao.stream( Vertex_sprite::UVRECT, *_stream, _uvRects.data(), _entries.size() );
+    _vao.stream( Vertex_sprite::TINT,   *_stream, _tints.data(),   _entries.size() );
+
+    // 2# One draw per run of equal state
+    const Shader* lastShader = nullptr;
+
+    for ( size_t first = 0; first < _entries.size(); ) {
+        const Entry& entry = _entries[first];
+
+        size_t last = first + 1;
+        while ( last < _entries.size() && _entries[last].layer == entry.layer
+                && _entries[last].shader == entry.shader && _entries[last].texture == entry.texture )
+            ++last;
+
+        entry.material->bind();
+        if ( entry.shader != lastShader ) {
+            entry.material->set_world( Affine2D::IDENTITY, 0 );
+            lastShader = entry.shader;
+        }
+
+        _vao.render_instanced( PrimitiveType::TRIANGLE_STRIP, 4, first, last - first );
+
+        first = last;
+    }
+
+    _entries.clear();
+}
+
+size_t SpriteBatch::size() const
+{
+    return _entries.size();
+}
+
+ENGINE_NAMESPACE_END
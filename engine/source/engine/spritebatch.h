@@ -0,0 +1,87 @@
+#pragma once
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                        Includes                        */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+// Std-Includes
+#include <vector>
+
+// Other Includes
+
+// Internal Includes
+#include "_gl.h"
+#include "_global.h"
+#include "_renderdefs.h"
+#include "noncopyable.h"
+#include "perfstats.h"
+
+#include "material.h"
+#include "affine2d.h"
+#include "vector2f.h"
+#include "vector4f.h"
+#include "vertex_sprite.h"
+#include "attribvertexarray.h"
+#include "streambuffer.h"
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Class                          */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+ENGINE_NAMESPACE_BEGIN
+
+// Collects sprites over a camera pass and draws them with one instanced
+// draw per run of sprites with equal layer, shader and texture.
+//
+// Every sprite is one Vertex_sprite instance on a shared unit quad, so it
+// costs one instance record instead of six vertices. Instances are in
+// world space, so batches draw with an identity world transform and the
+// camera's proj-view from CameraUniforms. Sprites draw in the order they
+// were added in, so add them sorted, e.g. by RenderQueue, whose key groups
+// sprites of equal depth by state. The instance data goes through the engine's
+// StreamBuffer, so uploading it never waits for the previous frame's draws.
+//
+//    batch.add( material, layer, instance );   // per sprite
+//    batch.flush();                            // before anything drawn outside the batch, and per camera
+class SpriteBatch : public noncopyable
+{
+public:
+    // See Vertex_sprite for the meaning of the fields
+    struct Instance {
+        Affine2D world;
+        float    depth;
+        Vector4f uvRect;
+        Vector4f tint;
+    };
+
+            explicit SpriteBatch( weak<StreamBuffer> stream );
+            ~SpriteBatch() = default;
+
+    // material has to stay alive until the next flush()
+    void    add( const Material& material, int32 layer, const Instance& instance );
+    void    flush();
+
+    size_t  size() const;
+
+private:
+    struct Entry {
+        int32           layer;
+        const Shader*   shader;
+        const Texture*  texture;
+        const Material* material;
+        Instance        instance;
+    };
+
+    weak<StreamBuffer>  _stream;
+    std::vector<Entry>  _entries;
+
+    // Per attribute streams in batch order
+    std::vector<float>  _worlds0;
+    std::vector<float>  _worlds1;
+    std::vector<float>  _depths;
+    std::vector<float>  _uvRects;
+    std::vector<float>  _tints;
+
+    AttribVertexArray<Vertex_sprite> _vao;
+};
+
+ENGINE_NAMESPACE_END
@@ -9,6 +9,7 @@ ENGINE_NAMESPACE_BEGIN
 
 SpriteRenderer::SpriteRenderer() : 
   _material( Material() ), _anchor( Vector2f(0,0) ), _size( Vector2f(1,1) ),
+  _instance{ Affine2D::IDENTITY, 0, Vector4f( 0, 0, 1, 1 ), Vector4f( 1, 1, 1, 1 ) },
   CurAnim(0), CurAnimKey(0),
   Anims{}, SubSprites{},
   StopWatch()
@@ -33,19 +34,26 @@ void SpriteRenderer::set_origin( Vector2f anchor )
 {
     _anchor = anchor;
     dirty = true;
+    mark_bounds_changed();
     // TODO: Remove anchor and handle via transform.position (?) Implement pivot point? 
 }
 
+void SpriteRenderer::set_tint( Vector4f tint )
+{
+    _instance.tint = tint;
+}
+
 void SpriteRenderer::set_size( Vector2f size )
 {
     _size = size;
     dirty = true;
+    mark_bounds_changed();
     // TODO: Remove size and handle via transform.scale 
 }
 
 void SpriteRenderer::on_init( RenderEngine& pRenderEngine )
 {   
-    _material.set_shader( pRenderEngine.get_shader( "builtin_texture" ) );
+    _material.set_shader( pRenderEngine.get_shader( "builtin_sprite" ) );
     StopWatch.start();
     on_dirty();
 }
@@ -53,13 +61,12 @@ void SpriteRenderer::on_init( RenderEngine& pRenderEngine )
 void SpriteRenderer::on_render( RenderEngine& pRenderEngine, Camera& pCamera, Matrix4f& pProjViewMat, float pInterpolation )
 {
     auto entity = get_entity();
+    const RenderSnapshot& snapshot = pRenderEngine.get_snapshot();
 
-    if (entity.has<CControllable>()) {
-      auto& ctrl = entity.get<CControllable>();
-
-      if (ctrl.moveLeft)
+    if (const RenderSnapshot::Motion* motion = snapshot.find_motion(entity)) {
+      if (motion->moveLeft)
         CurAnim = 1;
-      else if (ctrl.moveRight)
+      else if (motion->moveRight)
         CurAnim = 2;
       else
         CurAnim = 0;
@@ -74,39 +81,17 @@ void SpriteRenderer::on_render( RenderEngine& pRenderEngine, Camera& pCamera, Ma
       on_dirty();
     }
 
-    Vector3f position;
-    Vector3f scale;
-    Quaternion4f rotation;
+    // Interpolated by the engine for all entities at once, as we are between the last two ticks
+    const WorldTransforms& transforms = pRenderEngine.get_world_transforms();
+    uint32 index = transforms.index_of( entity );
+    const WorldTransforms::Pose& pose = transforms.pose( index );
 
-    if ( entity.has<CTransform>() ) {
-        CTransform& transform = entity.get<CTransform>();
+    // Unit quad to the anchored bottom-left corner and size, then into the world
+    _instance.world = transforms.world( index ) * Affine2D::trs<false>( _corner.x, _corner.y, 1, 0, _size.x, _size.y );
+    _instance.depth = pose.position.z;
 
-        // Interpolate transform, as we are between a calculated tick and a future tick
-        position = Vector3f::lerp( transform.lastPosition, transform.position, pInterpolation );
-        scale = Vector3f::lerp( transform.lastScale, transform.scale, pInterpolation );
-        rotation = Quaternion4f::slerp( transform.lastRotation, transform.rotation, pInterpolation );
-    }
-    else {
-        position = Vector3f( 0, 0, 0 );
-        scale = Vector3f( 1, 1, 1 );
-        rotation = Quaternion4f();
-    }
-
-    Matrix4f matPos = Matrix4f::translation( position );
-    Matrix4f matScale = Matrix4f::scaling( scale );
-    Matrix4f matRot = Quaternion4f::to_rotation_mat4f( rotation );
-
-#ifdef MAT4_ROW_MAJOR
-    Matrix4f world  = (matScale * matRot) * matPos;
-    Matrix4f wvp    = pProjViewMat * world;
-#else
-    Matrix4f world = (matPos * matRot) * matScale;
-    Matrix4f wvp    = world * pProjViewMat;
-#endif
-
-    _material.set_wvp( wvp );
-    _material.bind();
-    _svao.render_all();
+    // Drawn together with all other sprites sharing shader, texture and layer
+    pRenderEngine.get_sprite_batch().add( _material, render_layer(), _instance );
 }
 
 void SpriteRenderer::on_cleanup( RenderEngine& pRenderEngine )
@@ -125,8 +110,7 @@ void SpriteRenderer::on_dirty()
   auto& anim_key = anim.keys[CurAnimKey];
   auto& sub_sprite = SubSprites[anim_key.subSprite];
 
-  // 2# Repopulate VertexBuffer
-  _svao.get_vertex_buffer()->clear();
+  // 2# Recalculate corner and texture coordinates
   // Calcualte hellper variables for setting up the anchoring like
   //              [-1, 1] [0, 1] [1, 1]
   //              [-1, 0] [0, 0] [1, 0]
@@ -142,27 +126,30 @@ void SpriteRenderer::on_dirty()
   float x = _anchor.x * w;
   float y = _anchor.y * h;
 
-  auto v0 = Vertex_pt( {  w -x, -h -y, 0 }, { sw, vh } );
-  auto v1 = Vertex_pt( { -w -x, -h -y, 0 }, { u,  vh } );
-  auto v2 = Vertex_pt( {  w -x,  h -y, 0 }, { sw, v } );
-  auto v3 = Vertex_pt( { -w -x,  h -y, 0 }, { u,  v } );
-
-  auto vertices = std::vector<Vertex_pt>{
-      v0, v1, v2,
-      v1, v2, v3
-  };
-  _svao.get_vertex_buffer()->add_vertices( vertices );
+  _corner          = Vector2f( -w -x, -h -y );
+  _instance.uvRect = Vector4f( u, vh, sw, v );
 
   // 3# Mark as clean
   dirty = false;
 }
 
-float SpriteRenderer::render_layer_priority() const
+const Material* SpriteRenderer::render_material() const
 {
-    if ( get_entity().has<CTransform>() )
-        return get_entity().get<CTransform>().position.z;
-    else
-        return FLT_MAX;
+    return &_material;
+}
+
+bool SpriteRenderer::batches_sprites() const
+{
+    return true;
+}
+
+optional<Rect4f> SpriteRenderer::local_bounds( const RenderSnapshot& ) const
+{
+    // The quad on_dirty() places, from anchor and size so it is right before the first render
+    float w = _size.x / 2;
+    float h = _size.y / 2;
+
+    return Rect4f( -w - _anchor.x * w, -h - _anchor.y * h, _size.x, _size.y );
 }
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
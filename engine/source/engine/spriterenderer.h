@@ -13,8 +13,7 @@
 #include "shader.h"
 #include "material.h"
 #include "texture.h"
-#include "simplevertexarray.h"
-#include "attribvertexarray.h"
+#include "spritebatch.h"
 #include "stopwatch.h"
 
 ENGINE_NAMESPACE_BEGIN
@@ -71,9 +70,12 @@ public:
     void    set_texture( weak<Texture> );
     void    set_origin( Vector2f );
     void    set_size( Vector2f );
+    void    set_tint( Vector4f );
 
     // Inhereted by Renderer
-    virtual float render_layer_priority() const override;
+    virtual const Material* render_material() const override;
+    virtual optional<Rect4f> local_bounds( const RenderSnapshot& ) const override;
+    virtual bool batches_sprites() const override;
 
 protected:
     // Inhereted by Renderer
@@ -88,7 +90,11 @@ private:
     Vector2f                    _anchor;
     Material                    _material;
 
-    SimpleVertexArray<Vertex_pt> _svao;
+    // Bottom-left corner relative to the entity position, before scaling
+    Vector2f                    _corner;
+
+    // Handed to the SpriteBatch each frame, the transform is updated per frame
+    SpriteBatch::Instance       _instance;
 
     static Logger LOGGER;
 };
@@ -0,0 +1,152 @@
+#include "stdafx.h"
+#include "streambuffer.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Public                         */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+StreamBuffer::StreamBuffer( size_t capacity )
+    : _id( 0 ), _capacity( capacity ), _head( 0 ), _tail( 0 )
+{
+    Requires( capacity > 0 );
+
+    native_create();
+}
+
+StreamBuffer::~StreamBuffer()
+{
+    for ( Frame& frame : _frames )
+        glDeleteSync( frame.fence );
+
+    glDeleteBuffers( 1, &_id );
+    GLStateCache::instance().forget_buffer( _id );
+}
+
+size_t StreamBuffer::write( const void* data, size_t bytes, size_t alignment )
+{
+    Requires( alignment > 0 );
+    Guard( bytes > 0 ) return 0;
+
+    // 1# Find a contiguous range, data never wraps around the end of the ring
+    size_t offset = claim( bytes, alignment );
+
+    // 2# Copy, nothing in this range is used by the GPU anymore
+    GLStateCache::instance().bind_buffer( GL_ARRAY_BUFFER, _id );
+
+    void* target = glMapBufferRange( GL_ARRAY_BUFFER, offset, bytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT );
+    if ( target != nullptr ) {
+        std::memcpy( target, data, bytes );
+        glUnmapBuffer( GL_ARRAY_BUFFER );
+    }
+    else {
+        glBufferSubData( GL_ARRAY_BUFFER, offset, bytes, data );
+    }
+
+    _head += bytes;
+    return offset;
+}
+
+void StreamBuffer::reserve( size_t bytes )
+{
+    Guard( bytes > 0 ) return;
+
+    claim( bytes, 1 );
+}
+
+void StreamBuffer::end_frame()
+{
+    // Nothing written, the previous fence already covers everything
+    Guard( _frames.empty() || _frames.back().end != _head ) return;
+    Guard( _head != _tail ) return;
+
+    _frames.push_back( { glFenceSync( GL_SYNC_GPU_COMMANDS_COMPLETE, 0 ), _head } );
+}
+
+GLuint StreamBuffer::gl_id() const
+{
+    return _id;
+}
+
+size_t StreamBuffer::capacity() const
+{
+    return _capacity;
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Private                        */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+size_t StreamBuffer::claim( size_t bytes, size_t alignment )
+{
+    _head = (_head + alignment - 1) / alignment * alignment;
+
+    size_t offset = (size_t)(_head % _capacity);
+    if ( offset + bytes > _capacity ) {
+        _head += _capacity - offset;
+        offset = 0;
+    }
+
+    if ( !wait_for_space( bytes ) ) {
+        // This frame alone outgrew the ring
+        while ( _capacity < bytes * 2 ) _capacity *= 2;
+        _capacity *= 2;
+
+        LOGGER.log( Level::WARN ) << "Frame exceeds the ring, orphan and grow to " << _capacity << " bytes\n";
+        native_orphan();
+        offset = 0;
+    }
+
+    return offset;
+}
+
+void StreamBuffer::native_create()
+{
+    glGenBuffers( 1, &_id );
+    GLStateCache::instance().bind_buffer( GL_ARRAY_BUFFER, _id );
+    glBufferData( GL_ARRAY_BUFFER, _capacity, nullptr, GL_STREAM_DRAW );
+}
+
+void StreamBuffer::native_orphan()
+{
+    // The driver keeps the old storage alive for the draws still using it
+    GLStateCache::instance().bind_buffer( GL_ARRAY_BUFFER, _id );
+    glBufferData( GL_ARRAY_BUFFER, _capacity, nullptr, GL_STREAM_DRAW );
+
+    for ( Frame& frame : _frames )
+        glDeleteSync( frame.fence );
+
+    _frames.clear();
+    _head = 0;
+    _tail = 0;
+}
+
+bool StreamBuffer::wait_for_space( size_t bytes )
+{
+    while ( _head + bytes - _tail > _capacity ) {
+        Guard( !_frames.empty() ) return false;
+
+        Frame& oldest = _frames.front();
+
+        // Usually signaled long ago, a frame or two of latency is all the ring has to cover
+        if ( glClientWaitSync( oldest.fence, 0, 0 ) != GL_ALREADY_SIGNALED ) {
+            LOGGER.log( Level::DEBUG ) << "Waiting for the GPU to release the ring\n";
+            while ( glClientWaitSync( oldest.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000 ) == GL_TIMEOUT_EXPIRED ) { }
+        }
+
+        glDeleteSync( oldest.fence );
+        _tail = oldest.end;
+        _frames.pop_front();
+    }
+
+    return true;
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                      Private Static                    */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+Logger StreamBuffer::LOGGER = Logger( "StreamBuffer", Level::WARN );
+
+ENGINE_NAMESPACE_END
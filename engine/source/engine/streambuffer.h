@@ -0,0 +1,87 @@
+#pragma once
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                        Includes                        */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+// Std-Includes
+#include <deque>
+#include <cstring>
+
+// Other Includes
+
+// Internal Includes
+#include "_gl.h"
+#include "_global.h"
+#include "noncopyable.h"
+#include "logger.h"
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Class                          */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+ENGINE_NAMESPACE_BEGIN
+
+// One large GL buffer used as a ring for data that changes every frame.
+//
+// write() maps the next free range with GL_MAP_UNSYNCHRONIZED_BIT, so the
+// driver never waits for draws still reading older data. Instead each
+// frame is fenced in end_frame(), and write() only waits on a fence when
+// the ring wrapped around onto data of a frame the GPU hasn't finished.
+// A single frame that doesn't fit orphans the buffer and starts over
+// with twice the capacity. That drops the offsets of this frame's earlier
+// writes, so data that is drawn together is reserve()d together first.
+//
+//    size_t offset = stream.write( data, bytes );
+//    glVertexAttribPointer( ..., BUFFER_OFFSET( offset ) );   // with stream.gl_id() bound
+//    ...
+//    stream.end_frame();
+class StreamBuffer : public noncopyable
+{
+public:
+    static const size_t DEFAULT_CAPACITY = 4 * 1024 * 1024;
+
+            explicit StreamBuffer( size_t capacity = DEFAULT_CAPACITY );
+            ~StreamBuffer();
+
+    // Copies bytes into the ring and returns their offset in the GL buffer
+    size_t  write( const void* data, size_t bytes, size_t alignment = 16 );
+
+    // Makes room for the next writes, bytes including their alignment
+    // padding. They then neither wrap nor orphan the buffer.
+    void    reserve( size_t bytes );
+
+    // Fences everything written since the last call, once per frame after the last draw
+    void    end_frame();
+
+    GLuint  gl_id() const;
+    size_t  capacity() const;
+
+private:
+    struct Frame {
+        GLsync  fence;
+        uint64  end;
+    };
+
+    // Aligns _head onto a contiguous, free range of bytes and returns its offset
+    size_t  claim( size_t bytes, size_t alignment );
+
+    void    native_create();
+    void    native_orphan();
+
+    // Retires frames until [_head, _head + bytes) is free, false if only the current frame is left
+    bool    wait_for_space( size_t bytes );
+
+    GLuint              _id;
+    size_t              _capacity;
+
+    // Monotonic byte positions, the ring offset is position % _capacity.
+    // Everything before _tail has been consumed by the GPU.
+    uint64              _head;
+    uint64              _tail;
+
+    std::deque<Frame>   _frames;
+
+    static Logger LOGGER;
+};
+
+ENGINE_NAMESPACE_END
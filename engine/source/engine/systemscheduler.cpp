@@ -0,0 +1,178 @@
+#include "stdafx.h"
+#include "systemscheduler.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                      System - Public                   */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+System::System( string name, int32 priority )
+    : _name( name ), _priority( priority ), _chunkSize( DEFAULT_CHUNK_SIZE )
+{
+
+}
+
+System& System::run( function<void( float )> func )
+{
+    return run_chunked( []() { return size_t( 1 ); },
+                        [func]( float delta, size_t, size_t ) { func( delta ); },
+                        1 );
+}
+
+System& System::run_chunked( size_func_t size, kernel_t func, size_t chunkSize )
+{
+    Requires( chunkSize > 0 );
+
+    _size      = size;
+    _kernel    = func;
+    _chunkSize = chunkSize;
+    return *this;
+}
+
+const string& System::get_name() const
+{
+    return _name;
+}
+
+int32 System::get_priority() const
+{
+    return _priority;
+}
+
+bool System::conflicts_with( const System& other ) const
+{
+    return intersects( _writes, other._writes )
+        || intersects( _writes, other._reads )
+        || intersects( _reads, other._writes );
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                     System - Private                   */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+bool System::intersects( const std::vector<std::type_index>& a, const std::vector<std::type_index>& b )
+{
+    for ( auto& type : a )
+        if ( std::find( b.begin(), b.end(), type ) != b.end() )
+            return true;
+
+    return false;
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                 SystemScheduler - Public               */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+SystemScheduler::SystemScheduler( weak<JobSystem> jobs )
+    : _jobs( jobs ), _graphDirty( false ), _delta( 0 ), _pendingNodes( 0 )
+{
+    Requires( jobs );
+}
+
+void SystemScheduler::add( System system )
+{
+    Requires( system._kernel != nullptr );
+
+    _nodes.push_back( make_unique<Node>( std::move( system ) ) );
+    _graphDirty = true;
+}
+
+void SystemScheduler::clear()
+{
+    _nodes.clear();
+    _graphDirty = false;
+}
+
+void SystemScheduler::run( float delta )
+{
+    Guard( !_nodes.empty() ) return;
+
+    if ( _graphDirty )
+        build_graph();
+
+    _delta        = delta;
+    _pendingNodes = (uint32)_nodes.size();
+
+    for ( auto& node : _nodes )
+        node->pendingDependencies = node->numDependencies;
+
+    // Collect the roots first, starting one may already finish it and touch its dependents
+    std::vector<size_t> roots;
+    for ( size_t i = 0; i < _nodes.size(); ++i )
+        if ( _nodes[i]->numDependencies == 0 )
+            roots.push_back( i );
+
+    for ( size_t root : roots )
+        start_node( root );
+
+    _jobs->wait( _pendingNodes );
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                SystemScheduler - Private               */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+void SystemScheduler::build_graph()
+{
+    std::stable_sort( _nodes.begin(), _nodes.end(), []( const unique<Node>& a, const unique<Node>& b ) {
+        return a->system.get_priority() < b->system.get_priority();
+    } );
+
+    for ( auto& node : _nodes ) {
+        node->dependents.clear();
+        node->numDependencies = 0;
+    }
+
+    // Every conflicting pair is ordered by priority, non-conflicting pairs stay unordered
+    for ( size_t i = 0; i < _nodes.size(); ++i ) {
+        for ( size_t j = i + 1; j < _nodes.size(); ++j ) {
+            Guard( _nodes[i]->system.conflicts_with( _nodes[j]->system ) ) continue;
+
+            _nodes[i]->dependents.push_back( j );
+            _nodes[j]->numDependencies++;
+        }
+    }
+
+    _graphDirty = false;
+}
+
+void SystemScheduler::start_node( size_t index )
+{
+    Node&  node      = *_nodes[index];
+    size_t size      = node.system._size();
+    size_t chunkSize = node.system._chunkSize;
+    uint32 numChunks = (uint32)((size + chunkSize - 1) / chunkSize);
+
+    if ( numChunks == 0 ) {
+        finish_node( index );
+        return;
+    }
+
+    node.pendingChunks = numChunks;
+
+    for ( uint32 chunk = 0; chunk < numChunks; ++chunk ) {
+        size_t begin = chunk * chunkSize;
+        size_t end   = std::min( begin + chunkSize, size );
+
+        _jobs->submit( [this, index, begin, end]() {
+            Node& node = *_nodes[index];
+            node.system._kernel( _delta, begin, end );
+
+            if ( --node.pendingChunks == 0 )
+                finish_node( index );
+        } );
+    }
+}
+
+void SystemScheduler::finish_node( size_t index )
+{
+    for ( size_t dependent : _nodes[index]->dependents )
+        if ( --_nodes[dependent]->pendingDependencies == 0 )
+            start_node( dependent );
+
+    // Last, so run() cannot return while dependents are still being started
+    _pendingNodes--;
+}
+
+ENGINE_NAMESPACE_END
@@ -0,0 +1,146 @@
+#pragma once
+
+// Std-Includes
+#include <typeindex>
+#include <typeinfo>
+
+// Other Includes
+
+// Internal Includes
+#include "_global.h"
+#include "jobsystem.h"
+#include "view.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+// A unit of per-tick logic together with the component types it reads
+// and writes. The sets are what the scheduler uses to decide which
+// systems may overlap, so they have to be complete. Structural changes
+// (spawn, destroy, add, remove) go through CommandBuffer::local().
+//
+//    System( "controllable", CControllable::get_priority() )
+//        .reads<CControllable>()
+//        .writes<CTransform>()
+//        .each<CControllable, CTransform>( []( float delta, Entity e, CControllable& c, CTransform& t ) { ... } );
+class System
+{
+public:
+    typedef function<size_t()>                                      size_func_t;
+    typedef function<void( float delta, size_t begin, size_t end )> kernel_t;
+
+    static const size_t DEFAULT_CHUNK_SIZE = 256;
+
+            System( string name, int32 priority );
+
+    template<typename... COMPONENTS>
+    System& reads();
+
+    template<typename... COMPONENTS>
+    System& writes();
+
+    // Runs func( delta ) once per tick as a single task
+    System& run( function<void( float )> func );
+
+    // Runs func( delta, begin, end ) over [0, size()) split into chunks of chunkSize
+    System& run_chunked( size_func_t size, kernel_t func, size_t chunkSize = DEFAULT_CHUNK_SIZE );
+
+    // Runs func( delta, entity, components... ) over View<COMPONENTS...>, chunked along the first pool
+    template<typename... COMPONENTS, typename FUNC>
+    System& each( FUNC func, size_t chunkSize = DEFAULT_CHUNK_SIZE );
+
+    const string&   get_name() const;
+    int32           get_priority() const;
+
+    // True if both systems touch a component type and at least one of them writes it
+    bool            conflicts_with( const System& other ) const;
+
+private:
+    friend class SystemScheduler;
+
+    static bool     intersects( const std::vector<std::type_index>& a, const std::vector<std::type_index>& b );
+
+    string                          _name;
+    int32                           _priority;
+
+    std::vector<std::type_index>    _reads;
+    std::vector<std::type_index>    _writes;
+
+    size_func_t                     _size;
+    kernel_t                        _kernel;
+    size_t                          _chunkSize;
+};
+
+// Runs the registered systems once per tick on the JobSystem.
+//
+// Systems are ordered by priority (lower first, registration order on
+// ties). A system depends on every earlier system it conflicts with, which
+// gives a DAG: systems without a path between them run concurrently, and
+// each system is additionally split into chunks that are spread over the
+// workers. The calling thread helps out and returns once all systems have
+// finished.
+class SystemScheduler : public noncopyable
+{
+public:
+            explicit SystemScheduler( weak<JobSystem> jobs );
+
+    void    add( System system );
+    void    clear();
+
+    void    run( float delta );
+
+private:
+    struct Node {
+        System              system;
+        std::vector<size_t> dependents;
+        uint32              numDependencies = 0;
+
+        atomic<uint32>      pendingDependencies;
+        atomic<uint32>      pendingChunks;
+
+        Node( System s ) : system( std::move( s ) ), pendingDependencies( 0 ), pendingChunks( 0 ) { }
+    };
+
+    void    build_graph();
+    void    start_node( size_t index );
+    void    finish_node( size_t index );
+
+    weak<JobSystem>             _jobs;
+    std::vector<unique<Node>>   _nodes;
+    bool                        _graphDirty;
+
+    float                       _delta;
+    atomic<uint32>              _pendingNodes;
+};
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                   Template Definitions                 */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+template<typename... COMPONENTS>
+System& System::reads()
+{
+    ( _reads.push_back( std::type_index( typeid(COMPONENTS) ) ), ... );
+    return *this;
+}
+
+template<typename... COMPONENTS>
+System& System::writes()
+{
+    ( _writes.push_back( std::type_index( typeid(COMPONENTS) ) ), ... );
+    return *this;
+}
+
+template<typename... COMPONENTS, typename FUNC>
+System& System::each( FUNC func, size_t chunkSize )
+{
+    return run_chunked(
+        []() { return View<COMPONENTS...>().slice_size(); },
+        [func]( float delta, size_t begin, size_t end ) {
+            View<COMPONENTS...>().each_slice( begin, end, [&]( Entity entity, COMPONENTS&... components ) {
+                func( delta, entity, components... );
+            } );
+        },
+        chunkSize );
+}
+
+ENGINE_NAMESPACE_END
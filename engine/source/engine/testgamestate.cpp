@@ -3,6 +3,11 @@
 
 using namespace ENGINE_NAMESPACE;
 
+TestGameState::TestGameState() : _uiAspect( 1.0f )
+{
+
+}
+
 TestGameState::~TestGameState()
 {
 
@@ -33,7 +38,7 @@ void TestGameState::on_start()
       _player = Player_Spawner::Spawn(*logic, rendering, input, _mainScene);
 
       _tilemap = Tilemap_Spawner::Spawn(*logic, rendering, input, _mainScene);
-      _tilemap.get<CTransform>().position.z = -0.1f;
+      _tilemap.get<CTransform>().position().z = -0.1f;
     }
 }
 
@@ -54,6 +59,12 @@ void TestGameState::on_update()
             }
         }
     }
+
+    // UI
+    if ( CTransform* trans = _ui.try_get<CTransform>() ) {
+        trans->position().x = -0.95f * _uiAspect;
+        trans->position().y =  0.95f;
+    }
 }
 
 void TestGameState::on_frame_start() {
@@ -72,8 +83,8 @@ void TestGameState::on_frame_start() {
             _mainCamera->set_top( renderHeight/256.0f );
 
             // Main Camera Update
-            if ( _player.has<CTransform>() )
-                _mainCamera->set_target( _player.get<CTransform>().position );
+            if ( const RenderSnapshot::Transform* playerTransform = renderengine->get_snapshot().find_transform( _player ) )
+                _mainCamera->set_target( playerTransform->position );
         }
 
         if ( _uiCamera ) {
@@ -85,9 +96,7 @@ void TestGameState::on_frame_start() {
             _uiCamera->set_top( 1.0f );
             _uiCamera->set_viewport( { 0, 0, renderWidth, renderHeight } );
 
-            CTransform& trans = _ui.get<CTransform>();
-            trans.position.x = -0.95f * aspect;
-            trans.position.y =  0.95f;
+            _uiAspect = aspect;
         }
             
 
@@ -113,9 +122,9 @@ Entity TestGameState::spawn_ui( weak<Scene> scene )
     Entity ui = Entity::New();
     CTransform& trans = ui.add<CTransform>();
 
-    trans.position.x = -0.95f;
-    trans.position.y =  0.95f;
-    trans.position.z = -0.1f;
+    trans.position().x = -0.95f;
+    trans.position().y =  0.95f;
+    trans.position().z = -0.1f;
 
     if ( scene ) {
       auto tex = rendering->get_texture( "res/textures/healthmana.png" );
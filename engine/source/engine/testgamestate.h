@@ -26,7 +26,7 @@ class TestGameState : public GameState
 {
 
 public:
-            TestGameState() = default;
+            TestGameState();
             virtual ~TestGameState();
 
 protected:
@@ -53,4 +53,7 @@ private:
     Entity   _ui;
     weak<TextRenderer> _fpsText;
 
+    // Window aspect ratio, written by the render thread for the UI layout in on_update()
+    atomic<float>  _uiAspect;
+
 };
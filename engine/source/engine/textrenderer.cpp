@@ -3,6 +3,8 @@
 
 ENGINE_NAMESPACE_BEGIN
 
+static const float GLYPH_SIZE = 4.f;
+
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 /*                         Public                         */
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
@@ -13,7 +15,7 @@ TextRenderer::TextRenderer(weak<Tileset> pTileset) : TextRenderer(pTileset, Enti
 }
 
 TextRenderer::TextRenderer(weak<Tileset> pTileset, Entity pEntity ) :
-    _material( Material() ), _tileset( pTileset )
+    _material( Material() ), _tileset( pTileset ), _textWidth( 0 )
 {
     set_entity( pEntity );
     init_char_mapping();
@@ -23,11 +25,25 @@ void TextRenderer::set_text( string text )
 {
     _textChanged = _text != text;
     _text = text;
+
+    // Same advance as on_dirty(), which only runs once the text is rendered
+    uint32 pointer = 0;
+    _textWidth = 0;
+
+    for ( size_t i = 0; i < _text.length(); i++ ) {
+        auto map = _charMapping.find( (char32)_text.at( i ) );
+        uint32 width = map != _charMapping.end() ? map->second.width : 0;
+
+        _textWidth = std::max( _textWidth, pointer + GLYPH_SIZE );
+        pointer += (width-1);
+    }
+
+    mark_bounds_changed();
 }
 
 void TextRenderer::on_init( RenderEngine& pRenderEngine )
 {   
-    _material.set_shader( pRenderEngine.get_shader( "builtin_texture" ) );
+    _material.set_shader( pRenderEngine.get_shader( "builtin_sprite" ) );
     
     on_dirty();
 }
@@ -46,40 +62,25 @@ void TextRenderer::on_render( RenderEngine& pRenderEngine, Camera& pCamera, Matr
         on_dirty();
     }
 
-    Vector3f position;
-    Vector3f scale;
-    Quaternion4f rotation;
+    // Interpolated by the engine for all entities at once, as we are between the last two ticks
+    const WorldTransforms& transforms = pRenderEngine.get_world_transforms();
+    uint32 index = transforms.index_of( entity );
+    const WorldTransforms::Pose& pose = transforms.pose( index );
 
-    if ( entity.has<CTransform>() ) {
-        CTransform& transform = entity.get<CTransform>();
+    // Every glyph is a sprite, rotated and scaled around the text origin
+    const Affine2D& world = transforms.world( index );
 
-        // Interpolate transform, as we are between a calculated tick and a future tick
-        position = Vector3f::lerp( transform.lastPosition, transform.position, pInterpolation );
-        scale = Vector3f::lerp( transform.lastScale, transform.scale, pInterpolation );
-        rotation = Quaternion4f::slerp( transform.lastRotation, transform.rotation, pInterpolation );
-    }
-    else {
-        position = Vector3f( 0, 0, 0 );
-        scale = Vector3f( 1, 1, 1 );
-        rotation = Quaternion4f();
-    }
+    _material.set_texture_diffuse( _tileset->get_texture() );
 
-    Matrix4f matPos = Matrix4f::translation( position );
-    Matrix4f matScale = Matrix4f::scaling( scale );
-    Matrix4f matRot = Quaternion4f::to_rotation_mat4f( rotation );
+    SpriteBatch& batch = pRenderEngine.get_sprite_batch();
+    SpriteBatch::Instance instance{ Affine2D::IDENTITY, pose.position.z, Vector4f(), Vector4f( 1, 1, 1, 1 ) };
 
-#ifdef MAT4_ROW_MAJOR
-    Matrix4f world  = (matScale * matRot) * matPos;
-    Matrix4f wvp    = pProjViewMat * world;
-#else
-    Matrix4f world = (matPos * matRot) * matScale;
-    Matrix4f wvp    = world * pProjViewMat;
-#endif
+    for ( const Glyph& glyph : _glyphs ) {
+        instance.world  = world * Affine2D::trs<false>( glyph.offset.x, glyph.offset.y, 1, 0, GLYPH_SIZE, GLYPH_SIZE );
+        instance.uvRect = glyph.uvRect;
 
-    _material.set_texture_diffuse( _tileset->get_texture() );
-    _material.set_wvp( wvp );
-    _material.bind();
-    _svao.render_all();
+        batch.add( _material, render_layer(), instance );
+    }
 }
 
 void TextRenderer::on_cleanup( RenderEngine& pRenderEngine )
@@ -89,40 +90,15 @@ void TextRenderer::on_cleanup( RenderEngine& pRenderEngine )
 void TextRenderer::on_dirty()
 {
     uint32 pointer = 0;
-    std::vector<Vertex_pt> vertices = {};
+    _glyphs.clear();
 
     for ( size_t i = 0; i < _text.length(); i++ ) {
         char32 chr = _text.at( i );
         CharMapping map = _charMapping[chr];
 
-        float x0 = pointer + 0.0f;
-        float x1 = pointer + 4.f;
-        float y0 = 0.f;
-        float y1 = 4.f;
-
-        auto uvs = _tileset->get_uvs_by_index( map.index );
-
-        auto v0 = Vertex_pt( Vector3f( x1, y0, 0 ), Vector2f( uvs.max_x(), uvs.max_y() ) );
-        auto v1 = Vertex_pt( Vector3f( x0, y0, 0 ), Vector2f( uvs.min_x(), uvs.max_y() ) );
-        auto v2 = Vertex_pt( Vector3f( x1, y1, 0 ), Vector2f( uvs.max_x(), uvs.min_y() ) );
-        auto v3 = Vertex_pt( Vector3f( x0, y1, 0 ), Vector2f( uvs.min_x(), uvs.min_y() ) );
-
-        //auto v0 = Vertex_pt( Vector3f( x1, y0, 0 ), Vector2f( 1, 1 ) );
-        //auto v1 = Vertex_pt( Vector3f( x0, y0, 0 ), Vector2f( 0, 1 ) );
-        //auto v2 = Vertex_pt( Vector3f( x1, y1, 0 ), Vector2f( 1, 0 ) );
-        //auto v3 = Vertex_pt( Vector3f( x0, y1, 0 ), Vector2f( 0, 0 ) );
-
-        auto vrts = std::vector<Vertex_pt>{
-            v0, v1, v2,
-            v1, v2, v3
-        };
-
-        vertices.insert( vertices.end(), vrts.begin(), vrts.end() );
+        _glyphs.push_back( { Vector2f( (float)pointer, 0.f ), _tileset->get_uvrect_by_index( map.index ) } );
         pointer += (map.width-1);
     }
-
-    _svao.get_vertex_buffer()->clear();
-    _svao.get_vertex_buffer()->add_vertices( vertices );
 }
 
 void TextRenderer::init_char_mapping()
@@ -233,12 +209,19 @@ void TextRenderer::init_char_mapping()
     _charMapping['\''] = { 111, 2 };
 }
 
-float TextRenderer::render_layer_priority() const
+const Material* TextRenderer::render_material() const
+{
+    return &_material;
+}
+
+bool TextRenderer::batches_sprites() const
+{
+    return true;
+}
+
+optional<Rect4f> TextRenderer::local_bounds( const RenderSnapshot& ) const
 {
-    if ( get_entity().has<CTransform>() )
-        return get_entity().get<CTransform>().position.z;
-    else
-        return FLT_MAX;
+    return Rect4f( 0, 0, _textWidth, _textWidth > 0 ? GLYPH_SIZE : 0 );
 }
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
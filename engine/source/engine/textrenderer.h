@@ -13,8 +13,7 @@
 #include "shader.h"
 #include "material.h"
 #include "texture.h"
-#include "simplevertexarray.h"
-#include "attribvertexarray.h"
+#include "spritebatch.h"
 #include "tileset.h"
 
 ENGINE_NAMESPACE_BEGIN
@@ -38,7 +37,9 @@ public:
   void set_font_size( float );
 
   // Inhereted by Renderer
-  virtual float render_layer_priority() const override;
+  virtual const Material* render_material() const override;
+  virtual optional<Rect4f> local_bounds( const RenderSnapshot& ) const override;
+  virtual bool batches_sprites() const override;
 
 protected:
   // Inhereted by Renderer
@@ -57,8 +58,16 @@ private:
   weak<Tileset>                   _tileset;
   bool                            _tilesetInit;
 
-  SimpleVertexArray<Vertex_pt> _svao;
-  AttribVertexArray<Vertex_pt> _avao;
+  // Right edge of the last glyph, kept by set_text() for the bounds
+  float                           _textWidth;
+
+  // Glyph quads relative to the text origin, placed in the world per frame
+  struct Glyph {
+      Vector2f offset;
+      Vector4f uvRect;
+  };
+
+  std::vector<Glyph>              _glyphs;
 
   static Logger LOGGER;
 };
@@ -19,9 +19,7 @@ Texture::Texture(Image* image, TextureOptions options)
 
     // 2# Configure texture object
     glGenTextures(1, &_id);
-    glActiveTexture(GL_TEXTURE0);
-
-    glBindTexture(GL_TEXTURE_2D, _id);
+    GLStateCache::instance().bind_texture(GL_TEXTURE0, _id);
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -62,6 +60,7 @@ Texture::~Texture()
 {
     LOGGER.log(Level::DEBUG, _id) << "DELETE\n";
     glDeleteTextures( 1, &_id );
+    GLStateCache::instance().forget_texture( _id );
     PerfStats::instance().frame_unload_texture( _width * _height * _bpp );
 }
 
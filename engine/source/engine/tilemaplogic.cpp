@@ -13,10 +13,18 @@ void CTilemapLogic::reshape(uint32 pWidth, uint32 pHeight) {
   height = pHeight;
 
   tiles.resize(height * width, 0);
+
+  edits.clear();
+  mark_changed();
 }
 
 void CTilemapLogic::set_tile(uint32 x, uint32 y, uint32 tile) {
-  tiles[y * width + x] = tile;
+  uint32& current = tiles[y * width + x];
+  Guard(current != tile) return;
+
+  current = tile;
+  edits.push({ x, y });
+  mark_changed();
 }
 
 int  CTilemapLogic::get_tile(uint32 x, uint32 y) {
@@ -10,9 +10,15 @@
 #include "vector2f.h"
 #include "stopwatch.h"
 #include "component.h"
+#include "changelog.h"
 
 ENGINE_NAMESPACE_BEGIN
 
+struct TileEdit {
+  uint32 x;
+  uint32 y;
+};
+
 COMPONENT( CTilemapLogic, 10) 
 
   void update(float delta) override;
@@ -31,6 +37,8 @@ COMPONENT( CTilemapLogic, 10)
   PLAYER:
 
   LOCAL:
+    // set_tile() edits since a consumer's last look, cleared by reshape()
+    ChangeLog<TileEdit> edits;
 
 END
 
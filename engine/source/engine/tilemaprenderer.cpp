@@ -3,149 +3,231 @@
 
 ENGINE_NAMESPACE_BEGIN
 
-const uint32 TilemapRenderer::DATA_CHANGE_TEST_MS = 250;
+static const float TILE_SIZE = 0.5f;
 
 TilemapRenderer::TilemapRenderer( weak<Tileset> tileset, Entity entity) :
     _tileset( tileset ),
     _material( Material() ),
-    _anchor( Vector2f( 0, 0 ) )
+    _anchor( Vector2f( 0, 0 ) ),
+    _width( 0 ),
+    _height( 0 ),
+    _seenTick( 0 ),
+    _chunksPerRow( 0 )
 {
     set_entity( entity );
 }
 
 void TilemapRenderer::on_init( RenderEngine& pRenderEngine )
 {
-    _material.set_shader( pRenderEngine.get_shader( "builtin_texture" ) );
+    _material.set_shader( pRenderEngine.get_shader( "builtin_sprite" ) );
+    _heap = pRenderEngine.get_gpu_heap();
 
-    on_dirty();
-
-    LOGGER.log( Level::DEBUG ) << "init tilemaprenderer with id: " << _svao.get_vertex_buffer()->gl_id() << std::endl;
+    // Chunks are built on the first on_render(), once texture and snapshot are available
+    _vao.get_vertex_buffer( Vertex_sprite::CORNER )->add( Vertex_sprite::unit_quad() );
 }
 
-void TilemapRenderer::on_render( RenderEngine& pRenderEngine, Camera&, Matrix4f& pProjViewMat, float pInterpolation )
+void TilemapRenderer::on_render( RenderEngine& pRenderEngine, Camera& pCamera, Matrix4f&, float pInterpolation )
 {
     auto entity = get_entity();
+    const RenderSnapshot& snapshot = pRenderEngine.get_snapshot();
 
-    handle_tilemap_data_changed();
+    _material.set_texture_diffuse( _tileset->get_texture() );
+    handle_tilemap_data_changed( snapshot );
 
-    Vector3f position;
-    Vector3f scale;
-    Quaternion4f rotation;
+    // Interpolated by the engine for all entities at once, as we are between the last two ticks
+    const WorldTransforms& transforms = pRenderEngine.get_world_transforms();
+    uint32 index = transforms.index_of( entity );
 
-    if ( entity.has<CTransform>() ) {
-        CTransform& transform = entity.get<CTransform>();
+    Guard( !_chunks.empty() ) return;
 
-        // Interpolate transform, as we are between a calculated tick and a future tick
-        position = Vector3f::lerp( transform.lastPosition, transform.position, pInterpolation );
-        scale = Vector3f::lerp( transform.lastScale, transform.scale, pInterpolation );
-        rotation = Quaternion4f::slerp( transform.lastRotation, transform.rotation, pInterpolation );
-    }
-    else {
-        position = Vector3f( 0, 0, 0 );
-        scale = Vector3f( 1, 1, 1 );
-        rotation = Quaternion4f();
-    }
+    const Affine2D& world = transforms.world( index );
+    optional<Rect4f> view = pCamera.view_rect();
 
-    Matrix4f matPos = Matrix4f::translation( position );
-    Matrix4f matScale = Matrix4f::scaling( scale );
-    Matrix4f matRot = Quaternion4f::to_rotation_mat4f( rotation );
+    _material.set_world( world, transforms.pose( index ).position.z );
+    _material.bind();
 
-#ifdef MAT4_ROW_MAJOR
-    Matrix4f world = (matScale * matRot) * matPos;
-    Matrix4f wvp = pProjViewMat * world;
-#else
-    Matrix4f world = (matPos * matRot) * matScale;
-    Matrix4f wvp = world * pProjViewMat;
-#endif
+    // Chunks out of view are neither drawn nor get their edits uploaded
+    for ( Chunk& chunk : _chunks ) {
+        if ( view && !world.transform( chunk_rect( chunk ) ).overlaps( *view ) )
+            continue;
 
-    _material.set_texture_diffuse( _tileset->get_texture() );
-    _material.set_wvp( wvp );
-    _material.bind();
-    _svao.render_all();
+        render_chunk( chunk );
+    }
 }
 
 void TilemapRenderer::on_cleanup( RenderEngine& )
 {
+    free_chunks();
 }
 
-// TODO: Change this to an listener. Renderer subscribes to Logic, logic writes events in queue.
-void TilemapRenderer::handle_tilemap_data_changed()
+void TilemapRenderer::handle_tilemap_data_changed( const RenderSnapshot& snapshot )
 {
-    auto elapsed = _stopwatchUpdate.elapsed();
-    if ( elapsed < DATA_CHANGE_TEST_MS )
-        return;
+    const Tilemap* pTilemap = snapshot.find_tilemap( get_entity() );
+    if ( pTilemap == nullptr ) return;
+    auto& tilemap = *pTilemap;
 
-    _stopwatchUpdate.start();
-    LOGGER.log( Level::DEBUG ) << "react to data change\n";
+    bool built = tilemap.width == _width && tilemap.height == _height
+              && !_chunks.empty();
 
-    auto entity = get_entity();
+    if ( built && tilemap.changedTick <= _seenTick ) return;
 
-    if (entity.has<CTilemapLogic>()) {
-      auto& logic = entity.get<CTilemapLogic>();
-      auto& tiles = logic.tiles;
+    if ( built && tilemap.edits.covers( _seenTick ) ) {
+        LOGGER.log( Level::DEBUG ) << "apply tile edits\n";
+        tilemap.edits.each_since( _seenTick, [&]( const TileEdit& edit ) { update_tile( tilemap, edit.x, edit.y ); } );
+    }
+    else if ( !on_dirty( tilemap ) ) {
+        return;
+    }
 
-      bool tilemapUnchanged = true;
+    _seenTick = snapshot.tick();
+}
 
-      tilemapUnchanged &= (tiles.size() == _tmpTiles.size());
-      tilemapUnchanged &= std::equal(_tmpTiles.begin(), _tmpTiles.end(), tiles.begin());
+void TilemapRenderer::update_tile( const Tilemap& tilemap, uint32 x, uint32 y )
+{
+    // Position and size never change, only the tile shown
+    Chunk& chunk = _chunks[(y / CHUNK_SIZE) * _chunksPerRow + x / CHUNK_SIZE];
+    uint32 instance = (y - chunk.y) * chunk.width + (x - chunk.x);
+
+    const Vector4f& uvRect = tile_uvrect( tilemap, x, y );
+    float* dest = &chunk.uvRects[instance * 4];
+    dest[0] = uvRect.x;
+    dest[1] = uvRect.y;
+    dest[2] = uvRect.z;
+    dest[3] = uvRect.w;
+
+    chunk.uvDirty = true;
+}
 
-      if (!tilemapUnchanged) {
-        _tmpTiles.clear();
-        _tmpTiles.insert(_tmpTiles.end(), tiles.begin(), tiles.end());
-        on_dirty();
-      }
-    }
+const Vector4f& TilemapRenderer::tile_uvrect( const Tilemap& tilemap, uint32 x, uint32 y ) const
+{
+    return _tileset->get_uvrect_by_index( tilemap.tiles[y * tilemap.width + x] );
 }
 
-void TilemapRenderer::on_dirty()
+bool TilemapRenderer::on_dirty( const Tilemap& tilemap )
 {
     auto texture = _material.get_texture_diffuse();
-    if ( !texture ) return;
+    if ( !texture ) return false;
 
-    auto entity = get_entity();
-
-    if ( !entity.has<CTilemapLogic>() ) return;
-    auto& logic = entity.get<CTilemapLogic>();
+    // 1# Chunks of CHUNK_SIZE tiles, the ones at the right and top edge take the rest
+    free_chunks();
 
-    // 1# Create vertices
-    std::vector<Vertex_pt> vertices = {};
+    _width  = tilemap.width;
+    _height = tilemap.height;
+    mark_bounds_changed();
+    _chunksPerRow = (_width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    uint32 chunksPerCol = (_height + CHUNK_SIZE - 1) / CHUNK_SIZE;
 
-    for ( uint32 y = 0; y < logic.height; y++ )
-        for ( uint32 x = 0; x < logic.width; x++ ) {
-            float x0 = 0.5f*x;
-            float x1 = 0.5f*(x+1);
-            float y0 = 0.5f*y;
-            float y1 = 0.5f*(y+1);
+    _chunks.reserve( _chunksPerRow * chunksPerCol );
 
-            int index = logic.get_tile( x, y );
-            Rect4f uvs = _tileset->get_uvs_by_index( index );
+    // 2# Each uploaded into its own allocation
+    for ( uint32 cy = 0; cy < chunksPerCol; cy++ )
+        for ( uint32 cx = 0; cx < _chunksPerRow; cx++ ) {
+            uint32 x = cx * CHUNK_SIZE;
+            uint32 y = cy * CHUNK_SIZE;
 
-            auto v0 = Vertex_pt( Vector3f( x1, y0, 0 ), Vector2f( uvs.max_x(), uvs.max_y() ));
-            auto v1 = Vertex_pt( Vector3f( x0, y0, 0 ), Vector2f( uvs.min_x(), uvs.max_y() ));
-            auto v2 = Vertex_pt( Vector3f( x1, y1, 0 ), Vector2f( uvs.max_x(), uvs.min_y() ));
-            auto v3 = Vertex_pt( Vector3f( x0, y1, 0 ), Vector2f( uvs.min_x(), uvs.min_y() ));
+            Chunk chunk = { x, y, std::min( _width - x, (uint32)CHUNK_SIZE ), std::min( _height - y, (uint32)CHUNK_SIZE ),
+                            GpuHeap::INVALID_HANDLE, std::vector<float>(), false };
+            build_chunk( tilemap, chunk );
+            _chunks.push_back( std::move( chunk ) );
+        }
 
-            auto vrts = std::vector<Vertex_pt> {
-                v0, v1, v2,
-                v1, v2, v3
-            };
+    return true;
+}
 
-            vertices.insert( vertices.end(), vrts.begin(), vrts.end() );
-            
+void TilemapRenderer::build_chunk( const Tilemap& tilemap, Chunk& chunk )
+{
+    // 1# One instance per tile, TILE_SIZE wide
+    uint32 numTiles = chunk.width * chunk.height;
+
+    std::vector<float> worlds0, worlds1, depths, tints;
+    worlds0.reserve( numTiles * 3 );
+    worlds1.reserve( numTiles * 3 );
+    depths.reserve( numTiles );
+    tints.reserve( numTiles * 4 );
+
+    chunk.uvRects.clear();
+    chunk.uvRects.reserve( numTiles * 4 );
+
+    for ( uint32 y = chunk.y; y < chunk.y + chunk.height; y++ )
+        for ( uint32 x = chunk.x; x < chunk.x + chunk.width; x++ ) {
+            // In the tilemap's space, its world transform is applied per draw
+            Affine2D tile = Affine2D::trs<false>( TILE_SIZE*x, TILE_SIZE*y, 1, 0, TILE_SIZE, TILE_SIZE );
+
+            write_into( worlds0, Vector3f( tile.m00, tile.m01, tile.m02 ) );
+            write_into( worlds1, Vector3f( tile.m10, tile.m11, tile.m12 ) );
+            depths.push_back( 0 );
+            write_into( chunk.uvRects, tile_uvrect( tilemap, x, y ) );
+            write_into( tints,   Vector4f( 1, 1, 1, 1 ) );
         }
 
-    _svao.get_vertex_buffer()->clear();
-    _svao.get_vertex_buffer()->add_vertices( vertices );
+    // 2# block_offset() depends on the chunk's size
+    chunk.tiles   = _heap->allocate( block_offset( Vertex_sprite::NUM_ATTRIBS, numTiles ) );
+    chunk.uvDirty = false;
 
-    LOGGER.log( Level::DEBUG ) << "Tilemaprenderer with id: " << _svao.get_vertex_buffer()->gl_id() << "\n";
+    _heap->write( chunk.tiles, block_offset( Vertex_sprite::WORLD0, numTiles ), worlds0.data(),        (uint32)(worlds0.size() * FLOAT_BYTES) );
+    _heap->write( chunk.tiles, block_offset( Vertex_sprite::WORLD1, numTiles ), worlds1.data(),        (uint32)(worlds1.size() * FLOAT_BYTES) );
+    _heap->write( chunk.tiles, block_offset( Vertex_sprite::DEPTH,  numTiles ), depths.data(),         (uint32)(depths.size() * FLOAT_BYTES) );
+    _heap->write( chunk.tiles, block_offset( Vertex_sprite::UVRECT, numTiles ), chunk.uvRects.data(),  (uint32)(chunk.uvRects.size() * FLOAT_BYTES) );
+    _heap->write( chunk.tiles, block_offset( Vertex_sprite::TINT,   numTiles ), tints.data(),          (uint32)(tints.size() * FLOAT_BYTES) );
 }
 
-float TilemapRenderer::render_layer_priority() const
+void TilemapRenderer::render_chunk( Chunk& chunk )
 {
-    if ( get_entity().has<CTransform>() )
-        return get_entity().get<CTransform>().position.z;
-    else
-        return FLT_MAX;
+    uint32 numTiles = chunk.width * chunk.height;
+
+    // All edits since the last draw in one write
+    if ( chunk.uvDirty ) {
+        _heap->write( chunk.tiles, block_offset( Vertex_sprite::UVRECT, numTiles ), chunk.uvRects.data(), (uint32)(chunk.uvRects.size() * FLOAT_BYTES) );
+        chunk.uvDirty = false;
+    }
+
+    // Compaction may have moved the chunk since the last frame
+    GpuHeap::Slice slice = _heap->slice( chunk.tiles );
+
+    for ( uint32 attrib : { Vertex_sprite::WORLD0, Vertex_sprite::WORLD1, Vertex_sprite::DEPTH, Vertex_sprite::UVRECT, Vertex_sprite::TINT } )
+        _vao.source( attrib, slice.buffer, slice.offset + block_offset( attrib, numTiles ), numTiles );
+
+    _vao.render_instanced( PrimitiveType::TRIANGLE_STRIP, 4, 0, numTiles );
+}
+
+void TilemapRenderer::free_chunks()
+{
+    for ( Chunk& chunk : _chunks )
+        _heap->free( chunk.tiles );
+
+    _chunks.clear();
+}
+
+Rect4f TilemapRenderer::chunk_rect( const Chunk& chunk ) const
+{
+    return Rect4f( TILE_SIZE * chunk.x, TILE_SIZE * chunk.y, TILE_SIZE * chunk.width, TILE_SIZE * chunk.height );
+}
+
+uint32 TilemapRenderer::block_offset( uint32 attribLocation, uint32 numTiles )
+{
+    // Blocks in attribute order, each numTiles values long
+    static const uint32 BYTES[] = { 3 * FLOAT_BYTES, 3 * FLOAT_BYTES, 1 * FLOAT_BYTES, 4 * FLOAT_BYTES, 4 * FLOAT_BYTES };
+
+    uint32 offset = 0;
+    for ( uint32 attrib = Vertex_sprite::WORLD0; attrib < attribLocation; ++attrib )
+        offset += BYTES[attrib - Vertex_sprite::WORLD0] * numTiles;
+
+    return offset;
+}
+
+const Material* TilemapRenderer::render_material() const
+{
+    return &_material;
+}
+
+optional<Rect4f> TilemapRenderer::local_bounds( const RenderSnapshot& snapshot ) const
+{
+    // From the snapshot, the instances are only rebuilt once the map is rendered
+    const Tilemap* tilemap = snapshot.find_tilemap( get_entity() );
+    uint32 width  = tilemap != nullptr ? tilemap->width  : _width;
+    uint32 height = tilemap != nullptr ? tilemap->height : _height;
+
+    return Rect4f( 0, 0, TILE_SIZE * width, TILE_SIZE * height );
 }
 
 Logger TilemapRenderer::LOGGER = Logger( "TilemapRenderer", Level::WARN );
@@ -2,12 +2,15 @@
 
 // Std-Includes
 #include <algorithm>
+#include <vector>
 
 // Other Includes
 
 // Internal Includes
 #include "_global.h"
-#include "simplevertexarray.h"
+#include "attribvertexarray.h"
+#include "gpuheap.h"
+#include "vertex_sprite.h"
 #include "renderer.h"
 #include "tileset.h"
 #include "tilemaplogic.h"
@@ -17,27 +20,53 @@ ENGINE_NAMESPACE_BEGIN
 class TilemapRenderer : public Renderer
 {
 public:
-    static const uint32 DATA_CHANGE_TEST_MS;
-
     TilemapRenderer( weak<Tileset> tileset, Entity entity=Entity::None );
     ~TilemapRenderer() = default;
 
     // Inhereted by Renderer
-    virtual float render_layer_priority() const override;
+    virtual const Material* render_material() const override;
+    virtual optional<Rect4f> local_bounds( const RenderSnapshot& snapshot ) const override;
 protected:
 
     // Inhereted by Renderer
     virtual void on_init( RenderEngine& ) override;
-    virtual void on_render( RenderEngine&, Camera&, Matrix4f& pProjViewMat, float pInterpolation ) override;
+    virtual void on_render( RenderEngine&, Camera& pCamera, Matrix4f& pProjViewMat, float pInterpolation ) override;
     virtual void on_cleanup( RenderEngine& ) override;
 
 private:
-    void         on_dirty();
-    void         handle_tilemap_data_changed();
+    typedef RenderSnapshot::Tilemap Tilemap;
+
+    // Tiles per chunk side
+    static const uint32 CHUNK_SIZE = 32;
+
+    // A CHUNK_SIZE square of the map, smaller along the right and top edge.
+    // Uploaded, culled and drawn on its own, edits only touch their chunk.
+    struct Chunk {
+        uint32              x, y;           // First tile
+        uint32              width, height;  // In tiles
+        GpuHeap::Handle     tiles;
+
+        // Edits land here and go up as one write when the chunk is drawn next
+        std::vector<float>  uvRects;
+        bool                uvDirty;
+    };
+
+    // Rebuilds all chunks, false if the texture is not available yet
+    bool         on_dirty( const Tilemap& tilemap );
+    void         handle_tilemap_data_changed( const RenderSnapshot& snapshot );
+    void         update_tile( const Tilemap& tilemap, uint32 x, uint32 y );
+
+    void         build_chunk( const Tilemap& tilemap, Chunk& chunk );
+    void         render_chunk( Chunk& chunk );
+    void         free_chunks();
+
+    Rect4f       chunk_rect( const Chunk& chunk ) const;
+    const Vector4f& tile_uvrect( const Tilemap& tilemap, uint32 x, uint32 y ) const;
+
+    // Byte offset of each attribute block inside a chunk's allocation
+    static uint32 block_offset( uint32 attribLocation, uint32 numTiles );
 
 
-    float         _tileWidth;
-    float         _tileHeight;
     uint32        _width;
     uint32        _height;
 
@@ -45,10 +74,16 @@ private:
     weak<Tileset>  _tileset;
     Material       _material;
 
-    StopWatch           _stopwatchUpdate;
-    std::vector<int>    _tmpTiles;
+    // Logic tick of the tilemap data the instances were built from
+    tick_t              _seenTick;
+
+    // Row-major, ceil( _width / CHUNK_SIZE ) per row. Tile instances live in
+    // the shared heap, one allocation per chunk and one block per attribute.
+    weak<GpuHeap>                    _heap;
+    std::vector<Chunk>               _chunks;
+    uint32                           _chunksPerRow;
 
-    SimpleVertexArray<Vertex_pt> _svao;
+    AttribVertexArray<Vertex_sprite> _vao;
 
     static Logger LOGGER;
 };
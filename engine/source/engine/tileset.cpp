@@ -28,6 +28,15 @@ Rect4f Tileset::get_uvs_by_index( uint32 index )
     return Rect4f( x * uvPerX, y * uvPerY, uvPerX, uvPerY );
 }
 
+const Vector4f& Tileset::get_uvrect_by_index( uint32 index ) const
+{
+    // Whole texture, like get_uvs_by_index() without a texture
+    static const Vector4f WHOLE = Vector4f( 0, 1, 1, 0 );
+
+    Guard( index < _uvRects.size() ) return WHOLE;
+    return _uvRects[index];
+}
+
 weak<Texture> Tileset::get_texture()
 {
     return _texture;
@@ -62,6 +71,7 @@ uint32 Tileset::tiles_per_col()
 void Tileset::on_init( RenderEngine& pRenderEngine)
 {
     _texture = pRenderEngine.get_texture( _texturePath );
+    build_uvrects();
     cout << "Init Tileset\n";
 }
 
@@ -69,6 +79,24 @@ void Tileset::on_cleanup( RenderEngine& pRenderEngine )
 {
 }
 
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Private                        */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+void Tileset::build_uvrects()
+{
+    _uvRects.clear();
+    Guard( _texture ) return;
+
+    uint32 numTiles = tiles_per_row() * tiles_per_col();
+    _uvRects.reserve( numTiles );
+
+    for ( uint32 index = 0; index < numTiles; ++index ) {
+        Rect4f uvs = get_uvs_by_index( index );
+        _uvRects.push_back( Vector4f( uvs.min_x(), uvs.max_y(), uvs.max_x(), uvs.min_y() ) );
+    }
+}
+
 ENGINE_NAMESPACE_END
 
 
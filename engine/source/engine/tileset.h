@@ -5,6 +5,7 @@
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
 // Std-Includes
+#include <vector>
 
 // Other Includes
 #include "_gl.h"
@@ -14,6 +15,7 @@
 #include "texture.h"
 #include "material.h"
 #include "rect4f.h"
+#include "vector4f.h"
 #include "renderresource.h"
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
@@ -31,6 +33,11 @@ public:
             virtual ~Tileset() = default;
 
     Rect4f          get_uvs_by_index( uint32 index );
+
+    // Same uvs as instance uvrect ( bottom-left, top-right ), rows flipped.
+    // A lookup into a table built on init, no divisions per tile.
+    const Vector4f& get_uvrect_by_index( uint32 index ) const;
+
     weak<Texture>   get_texture();
     uint32          get_tile_width();
     uint32          get_tile_height();
@@ -52,6 +59,10 @@ private:
     uint32          _tileWidth;
     uint32          _tileHeight;
 
+    std::vector<Vector4f> _uvRects;  // By tile index, empty until the texture is known
+
+    void            build_uvrects();
+
     /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
     /*                     Private Static                     */
     /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
@@ -3,10 +3,96 @@
 
 ENGINE_NAMESPACE_BEGIN
 
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                      Public Static                     */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+TransformBuffer& CTransform::get_buffer() {
+    static TransformBuffer BUFFER;
+    return BUFFER;
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Public                         */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
 void CTransform::update(float delta) {
-    lastPosition = position;
-    lastScale    = scale;
-    lastRotation = rotation;
+    // Nothing to do, last values are kept by TransformBuffer::flip()
+}
+
+CTransform::CTransform()
+    : _slot( get_buffer().allocate() )
+{
+
+}
+
+CTransform::CTransform(CTransform&& other)
+    : Component( std::move( other ) ), _slot( other._slot )
+{
+    other._slot = NO_SLOT;
+}
+
+CTransform& CTransform::operator=(CTransform&& other) {
+    if ( this != &other ) {
+        if ( _slot != NO_SLOT )
+            get_buffer().release( _slot );
+
+        Component::operator=( std::move( other ) );
+        _slot = other._slot;
+        other._slot = NO_SLOT;
+    }
+    return *this;
+}
+
+CTransform::~CTransform() {
+    if ( _slot != NO_SLOT )
+        get_buffer().release( _slot );
+}
+
+uint32 CTransform::get_slot() const {
+    return _slot;
+}
+
+Vector3f& CTransform::position() {
+    get_buffer().mark_written( _slot );
+    mark_changed();
+    return get_buffer().current().position[_slot];
+}
+
+Vector3f& CTransform::scale() {
+    get_buffer().mark_written( _slot );
+    mark_changed();
+    return get_buffer().current().scale[_slot];
+}
+
+Quaternion4f& CTransform::rotation() {
+    get_buffer().mark_written( _slot );
+    mark_changed();
+    return get_buffer().current().rotation[_slot];
+}
+
+const Vector3f& CTransform::position() const {
+    return get_buffer().current().position[_slot];
+}
+
+const Vector3f& CTransform::scale() const {
+    return get_buffer().current().scale[_slot];
+}
+
+const Quaternion4f& CTransform::rotation() const {
+    return get_buffer().current().rotation[_slot];
+}
+
+const Vector3f& CTransform::last_position() const {
+    return get_buffer().previous().position[_slot];
+}
+
+const Vector3f& CTransform::last_scale() const {
+    return get_buffer().previous().scale[_slot];
+}
+
+const Quaternion4f& CTransform::last_rotation() const {
+    return get_buffer().previous().rotation[_slot];
 }
 
 ENGINE_NAMESPACE_END
@@ -9,23 +9,45 @@
 #include "vector3f.h"
 #include "quaternion4f.h"
 #include "component.h"
+#include "transformbuffer.h"
 
 ENGINE_NAMESPACE_BEGIN
 
+// Position, scale and rotation live in the shared TransformBuffer, the
+// component only owns a slot in it. Non-const accessors flag the slot as
+// written and mark the component changed, renderers read through the const ones.
 COMPONENT(CTransform, 0)
   void update(float delta) override;
 
+  static TransformBuffer& get_buffer();
+
+  CTransform();
+  CTransform(CTransform&& other);
+  CTransform& operator=(CTransform&& other);
+  ~CTransform();
+
+  uint32 get_slot() const;
+
 GLOBAL:
-    Vector3f        position = Vector3f(0, 0, 0);
-    Vector3f        scale = Vector3f(1, 1, 1);
-    Quaternion4f    rotation = Quaternion4f();
+  Vector3f&           position();
+  Vector3f&           scale();
+  Quaternion4f&       rotation();
+
+  const Vector3f&     position() const;
+  const Vector3f&     scale() const;
+  const Quaternion4f& rotation() const;
 
 PLAYER:
 
 LOCAL:
-    Vector3f        lastPosition = Vector3f(0, 0, 0);
-    Vector3f        lastScale = Vector3f(1, 1, 1);
-    Quaternion4f    lastRotation = Quaternion4f();
+  const Vector3f&     last_position() const;
+  const Vector3f&     last_scale() const;
+  const Quaternion4f& last_rotation() const;
+
+private:
+  static const uint32 NO_SLOT = ~uint32(0);
+
+  uint32 _slot;
 END
 
 ENGINE_NAMESPACE_END
@@ -0,0 +1,75 @@
+#include "stdafx.h"
+#include "transformbuffer.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Public                         */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+TransformBuffer::TransformBuffer()
+    : _current( 0 )
+{
+
+}
+
+uint32 TransformBuffer::allocate()
+{
+    uint32 slot;
+
+    if ( !_freeSlots.empty() ) {
+        slot = _freeSlots.back();
+        _freeSlots.pop_back();
+    }
+    else {
+        slot = (uint32)_written.size();
+
+        for ( Frame& frame : _frames ) {
+            frame.position.emplace_back();
+            frame.scale.emplace_back();
+            frame.rotation.emplace_back();
+        }
+        _written.push_back( 0 );
+    }
+
+    for ( Frame& frame : _frames ) {
+        frame.position[slot] = Vector3f( 0, 0, 0 );
+        frame.scale[slot]    = Vector3f( 1, 1, 1 );
+        frame.rotation[slot] = Quaternion4f();
+    }
+    _written[slot] = 0;
+
+    return slot;
+}
+
+void TransformBuffer::release( uint32 slot )
+{
+    Requires( slot < _written.size() );
+
+    _written[slot] = 0;
+    _freeSlots.push_back( slot );
+}
+
+void TransformBuffer::flip()
+{
+    const Frame& last = current();
+    _current ^= 1;
+    Frame& next = current();
+
+    // Both frames only differ where the last tick wrote
+    for ( uint32 slot = 0; slot < _written.size(); ++slot ) {
+        Guard( _written[slot] ) continue;
+
+        next.position[slot] = last.position[slot];
+        next.scale[slot]    = last.scale[slot];
+        next.rotation[slot] = last.rotation[slot];
+        _written[slot] = 0;
+    }
+}
+
+size_t TransformBuffer::capacity() const
+{
+    return _written.size();
+}
+
+ENGINE_NAMESPACE_END
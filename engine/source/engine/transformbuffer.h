@@ -0,0 +1,57 @@
+#pragma once
+
+// Std-Includes
+
+// Other Includes
+
+// Internal Includes
+#include "_global.h"
+#include "vector3f.h"
+#include "quaternion4f.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+// Double-buffered SoA storage behind all CTransforms.
+//
+// Logic writes the current frame, renderers interpolate between the
+// previous and the current frame. flip() at tick start swaps the two by
+// index. The new current frame is the one from two ticks ago, so only the
+// slots written during the last tick are copied over, untouched transforms
+// cost nothing.
+//
+// Slots are allocated and released on the logic thread only. Writers of
+// different slots may run concurrently.
+class TransformBuffer : public noncopyable
+{
+public:
+    struct Frame {
+        std::vector<Vector3f>       position;
+        std::vector<Vector3f>       scale;
+        std::vector<Quaternion4f>   rotation;
+    };
+
+            TransformBuffer();
+
+    uint32          allocate();
+    void            release( uint32 slot );
+
+    void            flip();
+
+    // Flags a slot to be carried over into the next frame on flip()
+    inline void     mark_written( uint32 slot )     { _written[slot] = 1; }
+
+    inline Frame&       current()                   { return _frames[_current]; }
+    inline const Frame& current() const             { return _frames[_current]; }
+    inline const Frame& previous() const            { return _frames[_current ^ 1]; }
+
+    size_t          capacity() const;
+
+private:
+    Frame                   _frames[2];
+    uint32                  _current;
+
+    std::vector<uint8>      _written;
+    std::vector<uint32>     _freeSlots;
+};
+
+ENGINE_NAMESPACE_END
@@ -0,0 +1,72 @@
+#pragma once
+
+// Std-Includes
+
+// Other Includes
+
+// Internal Includes
+#include "_global.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+// Lock-free single producer / single consumer hand-over of whole objects.
+//
+// The producer fills write() and publish()es it, the consumer acquire()s
+// the most recently published object. Neither side ever waits: the third
+// slot is where the last published object sits until one of the two sides
+// swaps it out. Objects that were published but never acquired are simply
+// overwritten, the consumer always sees the latest one.
+//
+// Slots are reused, so T should keep its allocations across refills.
+template<typename T>
+class TripleBuffer : public noncopyable
+{
+public:
+            TripleBuffer();
+
+    // Producer
+    T&          write();
+    void        publish();
+
+    // Consumer, stays valid until the next acquire()
+    const T&    acquire();
+
+private:
+    static const uint8 INDEX_MASK = 0x3;
+    static const uint8 FRESH_BIT  = 0x4;
+
+    T               _slots[3];
+
+    uint8           _writeIndex;
+    uint8           _readIndex;
+    atomic<uint8>   _middle;
+};
+
+template<typename T>
+TripleBuffer<T>::TripleBuffer()
+    : _writeIndex( 0 ), _readIndex( 1 ), _middle( 2 )
+{
+}
+
+template<typename T>
+T& TripleBuffer<T>::write()
+{
+    return _slots[_writeIndex];
+}
+
+template<typename T>
+void TripleBuffer<T>::publish()
+{
+    _writeIndex = _middle.exchange( _writeIndex | FRESH_BIT, std::memory_order_acq_rel ) & INDEX_MASK;
+}
+
+template<typename T>
+const T& TripleBuffer<T>::acquire()
+{
+    if ( _middle.load( std::memory_order_relaxed ) & FRESH_BIT )
+        _readIndex = _middle.exchange( _readIndex, std::memory_order_acq_rel ) & INDEX_MASK;
+
+    return _slots[_readIndex];
+}
+
+ENGINE_NAMESPACE_END
@@ -3,6 +3,7 @@
 
 ENGINE_NAMESPACE_BEGIN
 
-Uniform const Uniform::WORLD_VIEW_PROJ_MATRIX = Uniform( "mat4", "uni_wvp" );
+Uniform const Uniform::WORLD_MATRIX = Uniform( "mat2x3", "uni_world" );
+Uniform const Uniform::WORLD_DEPTH  = Uniform( "float", "uni_depth" );
 
 ENGINE_NAMESPACE_END
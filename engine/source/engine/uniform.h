@@ -27,7 +27,14 @@ public:
     /*                     Public Static                      */
     /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
-    static const Uniform WORLD_VIEW_PROJ_MATRIX;
+    // GL location, see Shader::uniform_handle()
+    typedef int32 Handle;
+    static const Handle INVALID_HANDLE = -1;
+
+    // 2D model transform, see Affine2D, and the depth it is drawn at.
+    // Proj-view comes from CameraUniforms.
+    static const Uniform WORLD_MATRIX;
+    static const Uniform WORLD_DEPTH;
 
     /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
     /*                        Public                          */
@@ -195,13 +195,12 @@ Vector3f& Vector3f::operator/=(const float o)
 
 Vector3f Vector3f::normalized() const
 {
-    Vector3f result = *this;
-    float len = result.length();
+    __m128 v = simd::load3( &x );
+    __m128 length = _mm_sqrt_ps( simd::dot4( v, v ) );
 
-    if (len != 0.0f) {
-        result.x = result.x / len;
-        result.y = result.y / len;
-        result.z = result.z / len;
+    Vector3f result = *this;
+    if ( _mm_cvtss_f32( length ) != 0.0f ) {
+        simd::store3( &result.x, _mm_div_ps( v, length ) );
     }
 
     return result;
@@ -219,10 +218,15 @@ float Vector3f::dot(Vector3f o) const
 
 Vector3f Vector3f::cross(Vector3f o) const
 {
-    Vector3f result = *this;
-    result.x = y * o.z - z * o.y;
-    result.y = z * o.x - x * o.z;
-    result.z = x * o.y - y * o.x;
+    // ( y z x ) * ( o.z o.x o.y ) - ( z x y ) * ( o.y o.z o.x )
+    __m128 a = simd::load3( &x );
+    __m128 b = simd::load3( &o.x );
+
+    __m128 c = _mm_sub_ps( _mm_mul_ps( SIMD_SWIZZLE( a, 1, 2, 0, 3 ), SIMD_SWIZZLE( b, 2, 0, 1, 3 ) ),
+                           _mm_mul_ps( SIMD_SWIZZLE( a, 2, 0, 1, 3 ), SIMD_SWIZZLE( b, 1, 2, 0, 3 ) ) );
+
+    Vector3f result;
+    simd::store3( &result.x, c );
     return result;
 }
 
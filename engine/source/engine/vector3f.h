@@ -11,6 +11,7 @@
 
 // Internal Includes
 #include "_global.h"
+#include "simd.h"
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 /*                         Class                          */
@@ -34,10 +34,7 @@ Vector4f::Vector4f(const float x, const float y, const float z, const float w)
 
 bool Vector4f::operator==(const Vector4f& o) const
 {
-    return x == o.x
-        && y == o.y
-        && z == o.z
-        && w == o.w;
+    return _mm_movemask_ps( _mm_cmpeq_ps( load(), o.load() ) ) == 0xF;
 }
 
 bool Vector4f::operator!=(const Vector4f & o) const
@@ -47,145 +44,117 @@ bool Vector4f::operator!=(const Vector4f & o) const
 
 Vector4f Vector4f::operator-() const
 {
-    Vector4f result;
-    result.x = -x;
-    result.y = -y;
-    result.z = -z;
-    result.w = -w;
-    return result;
+    return from( simd::negate( load(), _mm_set1_ps( -0.0f ) ) );
 }
 
 Vector4f Vector4f::operator+(const Vector4f o) const
 {
-    Vector4f result = *this;
-    result += o;
-    return result;
+    return from( _mm_add_ps( load(), o.load() ) );
 }
 
 Vector4f Vector4f::operator-(const Vector4f o) const
 {
-    Vector4f result = *this;
-    result -= o;
-    return result;
+    return from( _mm_sub_ps( load(), o.load() ) );
 }
 
 Vector4f Vector4f::operator*(const Vector4f o) const
 {
-    Vector4f result = *this;
-    result *= o;
-    return result;
+    return from( _mm_mul_ps( load(), o.load() ) );
 }
 
 Vector4f Vector4f::operator/(const Vector4f o) const
 {
-    Vector4f result = *this;
-    result /= o;
-    return result;
+    return from( _mm_div_ps( load(), o.load() ) );
 }
 
 
 Vector4f& Vector4f::operator+=(const Vector4f o)
 {
-    x += o.x;
-    y += o.y;
-    z += o.z;
-    w += o.w;
+    store( _mm_add_ps( load(), o.load() ) );
     return *this;
 }
 
 Vector4f& Vector4f::operator-=(const Vector4f o)
 {
-    x -= o.x;
-    y -= o.y;
-    z -= o.z;
-    w -= o.w;
+    store( _mm_sub_ps( load(), o.load() ) );
     return *this;
 }
 
 Vector4f& Vector4f::operator*=(const Vector4f o)
 {
-    x *= o.x;
-    y *= o.y;
-    z *= o.z;
-    w *= o.w;
+    store( _mm_mul_ps( load(), o.load() ) );
     return *this;
 }
 
 Vector4f& Vector4f::operator/=(const Vector4f o)
 {
-    x /= o.x;
-    y /= o.y;
-    z /= o.z;
-    w /= o.w;
+    store( _mm_div_ps( load(), o.load() ) );
     return *this;
 }
 
 
 Vector4f Vector4f::operator+(const float o) const
 {
-    Vector4f result = *this;
-    result += o;
-    return result;
+    return from( _mm_add_ps( load(), _mm_set1_ps( o ) ) );
 }
 
 Vector4f Vector4f::operator-(const float o) const
 {
-    Vector4f result = *this;
-    result -= o;
-    return result;
+    return from( _mm_sub_ps( load(), _mm_set1_ps( o ) ) );
 }
 
 Vector4f Vector4f::operator*(const float o) const
 {
-    Vector4f result = *this;
-    result *= o;
-    return result;
+    return from( _mm_mul_ps( load(), _mm_set1_ps( o ) ) );
 }
 
 Vector4f Vector4f::operator/(const float o) const
 {
-    Vector4f result = *this;
-    result /= o;
-    return result;
+    return from( _mm_div_ps( load(), _mm_set1_ps( o ) ) );
 }
 
 
 Vector4f& Vector4f::operator+=(const float o)
 {
-    x += o;
-    y += o;
-    z += o;
-    w += o;
+    store( _mm_add_ps( load(), _mm_set1_ps( o ) ) );
     return *this;
 }
 
 Vector4f& Vector4f::operator-=(const float o)
 {
-    x -= o;
-    y -= o;
-    z -= o;    
-    w -= o;
+    store( _mm_sub_ps( load(), _mm_set1_ps( o ) ) );
     return *this;
 }
 
 Vector4f& Vector4f::operator*=(const float o)
 {
-    x *= o;
-    y *= o;
-    z *= o;
-    w *= o;
+    store( _mm_mul_ps( load(), _mm_set1_ps( o ) ) );
     return *this;
 }
 
 Vector4f& Vector4f::operator/=(const float o)
 {
-    x /= o;
-    y /= o;
-    z /= o;
-    w /= o;
+    store( _mm_div_ps( load(), _mm_set1_ps( o ) ) );
     return *this;
 }
 
+Vector4f Vector4f::normalized() const
+{
+    __m128 v = load();
+    __m128 length = _mm_sqrt_ps( simd::dot4( v, v ) );
+
+    if ( _mm_cvtss_f32( length ) == 0.0f ) {
+        return *this;
+    }
+
+    return from( _mm_div_ps( v, length ) );
+}
+
+float Vector4f::length() const
+{
+    return _mm_cvtss_f32( _mm_sqrt_ss( simd::dot4( load(), load() ) ) );
+}
+
 vec4 Vector4f::toVec4() const
 {
     return { x, y, z, w };
@@ -11,6 +11,7 @@
 
 // Internal Includes
 #include "_global.h"
+#include "simd.h"
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 /*                         Class                          */
@@ -91,8 +92,31 @@ private:
     /*                        Private                         */
     /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
+    // Unaligned, Vector4f sits at any offset in vertex layouts like Vertex_pc
+    __m128  load() const;
+    void    store( __m128 v );
+
+    static Vector4f from( __m128 v );
+
 };
 
+inline __m128 Vector4f::load() const
+{
+    return _mm_loadu_ps( &x );
+}
+
+inline void Vector4f::store( __m128 v )
+{
+    _mm_storeu_ps( &x, v );
+}
+
+inline Vector4f Vector4f::from( __m128 v )
+{
+    Vector4f result;
+    result.store( v );
+    return result;
+}
+
 inline void write_into( std::vector<float>& vector, Vector4f value ) 
 {
     vector.insert( vector.end(), value.x );
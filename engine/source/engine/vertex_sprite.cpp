@@ -0,0 +1,55 @@
+#include "stdafx.h"
+#include "vertex_sprite.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                      Public Static                     */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+std::vector<Vector2f> Vertex_sprite::unit_quad()
+{
+    return { Vector2f( 0, 0 ), Vector2f( 1, 0 ), Vector2f( 0, 1 ), Vector2f( 1, 1 ) };
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Public                         */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+Vertex_sprite::Vertex_sprite( Vector2f corner, Affine2D world, float depth, Vector4f uvRect, Vector4f tint ) : Vertex()
+{
+    this->corner    = corner;
+    this->world     = world;
+    this->depth     = depth;
+    this->uvRect    = uvRect;
+    this->tint      = tint;
+
+    //
+    layout = VertexLayout( {
+                { "vec2",  "corner",   CORNER, 0 },
+                { "vec3",  "i_world0", WORLD0, 1 },
+                { "vec3",  "i_world1", WORLD1, 1 },
+                { "float", "i_depth",  DEPTH,  1 },
+                { "vec4",  "i_uvrect", UVRECT, 1 },
+                { "vec4",  "i_tint",   TINT,   1 }
+             } );
+
+    // Data Vector
+    data = std::vector<float>();
+    data.reserve( 17 );
+    write_into( data, corner );
+    write_into( data, Vector3f( world.m00, world.m01, world.m02 ) );
+    write_into( data, Vector3f( world.m10, world.m11, world.m12 ) );
+    data.push_back( depth );
+    write_into( data, uvRect );
+    write_into( data, tint );
+
+    // Byte size
+    bytesize = 17 * FLOAT_BYTES;
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Private                        */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+ENGINE_NAMESPACE_END
@@ -0,0 +1,56 @@
+#pragma once
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                        Includes                        */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+// Std-Includes
+#include <vector>
+
+// Other Includes
+
+// Internal Includes
+#include "_global.h"
+#include "vertex.h"
+#include "affine2d.h"
+#include "vector2f.h"
+#include "vector3f.h"
+#include "vector4f.h"
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Class                          */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+ENGINE_NAMESPACE_BEGIN
+
+/**
+ * Instanced textured quad, one corner per vertex and everything else per instance.
+ *
+ * layout:
+ *     vec2  corner;        unit quad, (0,0) bottom-left to (1,1) top-right
+ *     vec3  i_world0;      rows of the Affine2D placing the unit quad in the world,
+ *     vec3  i_world1;      size and corner offset included
+ *     float i_depth;       z
+ *     vec4  i_uvrect;      u, v at the bottom-left and at the top-right corner
+ *     vec4  i_tint;        multiplied with the texel
+ */
+struct Vertex_sprite : Vertex
+{
+public:
+    enum Attrib : uint32 { CORNER, WORLD0, WORLD1, DEPTH, UVRECT, TINT, NUM_ATTRIBS };
+
+    // Triangle strip
+    static std::vector<Vector2f> unit_quad();
+
+                Vertex_sprite( Vector2f corner = Vector2f( 0, 0 ), Affine2D world = Affine2D::IDENTITY, float depth = 0,
+                               Vector4f uvRect = Vector4f( 0, 0, 1, 1 ), Vector4f tint = Vector4f( 1, 1, 1, 1 ) );
+    virtual     ~Vertex_sprite() = default;
+
+    Vector2f corner;
+    Affine2D world;
+    float    depth;
+    Vector4f uvRect;
+    Vector4f tint;
+
+};
+
+ENGINE_NAMESPACE_END
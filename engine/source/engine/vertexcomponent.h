@@ -26,6 +26,9 @@ public:
     string name;
     uint32 position;
 
+    // Instances per step, 0 steps per vertex ( see glVertexAttribDivisor )
+    uint32 divisor = 0;
+
     uint32 num_components() const {
         if ( type == string( "float" ) )
             return 1;
@@ -61,7 +64,7 @@ public:
         return GL_NONE;
     }
 
-    bool operator==( const VertexComponent& o ) const { return type == o.type && name == o.name && position == o.position; }
+    bool operator==( const VertexComponent& o ) const { return type == o.type && name == o.name && position == o.position && divisor == o.divisor; }
     bool operator!=( const VertexComponent& o ) const { return !(*this == o); }
 };
 
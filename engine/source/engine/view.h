@@ -0,0 +1,149 @@
+#pragma once
+
+// Std-Includes
+#include <array>
+#include <tuple>
+#include <utility>
+
+// Other Includes
+
+// Internal Includes
+#include "_global.h"
+#include "compact_map.h"
+#include "entity.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+// Joins several component pools on their entity id.
+//
+// Iterates the smallest pool and probes the others through their sparse
+// index, so every matching entity costs one O(1) lookup per additional
+// component instead of a has<T>() + get<T>() pair. The callback receives
+// direct references into the pools:
+//
+//    View<CControllable, CTransform>().each(
+//        []( Entity e, CControllable& ctrl, CTransform& transform ) { ... } );
+//
+// each_slice() walks a slot range of the first pool instead, so disjoint
+// ranges can be handed to different threads.
+//
+// Pools must not be structurally modified (add/remove) during iteration.
+template<typename... COMPONENTS>
+class View
+{
+    static_assert(sizeof...(COMPONENTS) > 0, "View needs at least one component");
+
+public:
+    View();
+
+    size_t  size_hint() const;
+
+    template<typename FUNC>
+    void    each( FUNC&& func );
+
+    // Number of slots each_slice() ranges over, the size of the first pool
+    size_t  slice_size() const;
+
+    template<typename FUNC>
+    void    each_slice( size_t begin, size_t end, FUNC&& func );
+
+private:
+    typedef std::index_sequence_for<COMPONENTS...> indices_t;
+
+    template<size_t... I>
+    std::array<size_t, sizeof...(COMPONENTS)> pool_sizes( std::index_sequence<I...> ) const;
+
+    template<typename FUNC, size_t... I>
+    void    dispatch( size_t lead, FUNC& func, std::index_sequence<I...> );
+
+    template<size_t LEAD, typename FUNC, size_t... I>
+    void    each_lead( size_t begin, size_t end, FUNC& func, std::index_sequence<I...> );
+
+    template<size_t I, size_t LEAD>
+    auto    probe( entity_id id, size_t slot );
+
+    std::tuple<compact_map<entity_id, COMPONENTS>&...> _pools;
+};
+
+template<typename... COMPONENTS>
+View<COMPONENTS...>::View()
+    : _pools( COMPONENTS::get_all_components()... )
+{
+}
+
+// Upper bound of matching entities, the size of the smallest pool
+template<typename... COMPONENTS>
+size_t View<COMPONENTS...>::size_hint() const
+{
+    auto sizes = pool_sizes( indices_t() );
+    return *std::min_element( sizes.begin(), sizes.end() );
+}
+
+template<typename... COMPONENTS>
+template<typename FUNC>
+void View<COMPONENTS...>::each( FUNC&& func )
+{
+    auto   sizes = pool_sizes( indices_t() );
+    size_t lead  = std::min_element( sizes.begin(), sizes.end() ) - sizes.begin();
+
+    dispatch( lead, func, indices_t() );
+}
+
+template<typename... COMPONENTS>
+size_t View<COMPONENTS...>::slice_size() const
+{
+    return std::get<0>( _pools ).size();
+}
+
+template<typename... COMPONENTS>
+template<typename FUNC>
+void View<COMPONENTS...>::each_slice( size_t begin, size_t end, FUNC&& func )
+{
+    Requires( begin <= end && end <= slice_size() );
+
+    each_lead<0>( begin, end, func, indices_t() );
+}
+
+template<typename... COMPONENTS>
+template<size_t... I>
+std::array<size_t, sizeof...(COMPONENTS)> View<COMPONENTS...>::pool_sizes( std::index_sequence<I...> ) const
+{
+    return {{ std::get<I>( _pools ).size()... }};
+}
+
+template<typename... COMPONENTS>
+template<typename FUNC, size_t... I>
+void View<COMPONENTS...>::dispatch( size_t lead, FUNC& func, std::index_sequence<I...> seq )
+{
+    // Runtime pool index -> compile time lead pool
+    ( (lead == I ? each_lead<I>( 0, std::get<I>( _pools ).size(), func, seq ) : void()), ... );
+}
+
+template<typename... COMPONENTS>
+template<size_t LEAD, typename FUNC, size_t... I>
+void View<COMPONENTS...>::each_lead( size_t begin, size_t end, FUNC& func, std::index_sequence<I...> )
+{
+    const std::vector<entity_id>& ids = std::get<LEAD>( _pools ).keys();
+
+    for ( size_t slot = begin; slot < end; ++slot ) {
+        entity_id id = ids[slot];
+        std::tuple<COMPONENTS*...> comps( probe<I, LEAD>( id, slot )... );
+
+        Guard( ((std::get<I>( comps ) != nullptr) && ...) ) continue;
+
+        func( Entity( id ), *std::get<I>( comps )... );
+    }
+}
+
+template<typename... COMPONENTS>
+template<size_t I, size_t LEAD>
+auto View<COMPONENTS...>::probe( entity_id id, size_t slot )
+{
+    // The lead pool is walked by slot, no lookup needed
+    if constexpr ( I == LEAD )
+        return &std::get<I>( _pools ).values()[slot];
+    else
+        return std::get<I>( _pools ).try_access( id );
+}
+
+ENGINE_NAMESPACE_END
@@ -0,0 +1,149 @@
+#pragma once
+
+// Std-Includes
+#include <type_traits>
+#include <vector>
+
+// Other Includes
+
+// Internal Includes
+#include "_global.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+// Chase-Lev work-stealing deque (Le et al., "Correct and Efficient
+// Work-Stealing for Weak Memory Models").
+//
+// The owning thread push()es and pop()s at the bottom without locking,
+// any other thread steal()s from the top. Only a pop and a steal racing
+// for the last element meet on a CAS.
+//
+// The ring grows on demand. Rings that were outgrown are kept until the
+// deque dies, a thief may still be reading from one.
+template<typename T>
+class WorkStealingDeque : public noncopyable
+{
+    static_assert(std::is_trivially_copyable<T>::value, "WorkStealingDeque stores plain values, e.g. pointers");
+
+public:
+    explicit    WorkStealingDeque( size_t capacity = 256 );
+                ~WorkStealingDeque() = default;
+
+    // Owner thread only
+    void        push( T item );
+    bool        pop( T& item );
+
+    // Any thread, false if empty or another thread won the race
+    bool        steal( T& item );
+
+    // Racy, only good for heuristics
+    size_t      size_hint() const;
+
+private:
+    struct Ring {
+        size_t                  mask;
+        unique<atomic<T>[]>     items;
+
+        explicit Ring( size_t capacity ) : mask( capacity - 1 ), items( new atomic<T>[capacity] ) { }
+
+        T       load( int64 i ) const       { return items[i & mask].load( std::memory_order_relaxed ); }
+        void    store( int64 i, T item )    { items[i & mask].store( item, std::memory_order_relaxed ); }
+        size_t  capacity() const            { return mask + 1; }
+    };
+
+    atomic<int64>               _top;
+    atomic<int64>               _bottom;
+    atomic<Ring*>               _ring;
+
+    std::vector<unique<Ring>>   _rings;
+};
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                   Template Definitions                 */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+template<typename T>
+WorkStealingDeque<T>::WorkStealingDeque( size_t capacity )
+    : _top( 0 ), _bottom( 0 )
+{
+    Requires( capacity > 0 && (capacity & (capacity - 1)) == 0 );
+
+    _rings.push_back( make_unique<Ring>( capacity ) );
+    _ring.store( _rings.back().get(), std::memory_order_relaxed );
+}
+
+template<typename T>
+void WorkStealingDeque<T>::push( T item )
+{
+    int64 b = _bottom.load( std::memory_order_relaxed );
+    int64 t = _top.load( std::memory_order_acquire );
+    Ring* ring = _ring.load( std::memory_order_relaxed );
+
+    // Full, move the live range into a ring twice the size
+    if ( b - t > (int64)ring->mask ) {
+        auto bigger = make_unique<Ring>( ring->capacity() * 2 );
+        for ( int64 i = t; i < b; ++i )
+            bigger->store( i, ring->load( i ) );
+
+        ring = bigger.get();
+        _rings.push_back( std::move( bigger ) );
+        _ring.store( ring, std::memory_order_release );
+    }
+
+    ring->store( b, item );
+    std::atomic_thread_fence( std::memory_order_release );
+    _bottom.store( b + 1, std::memory_order_relaxed );
+}
+
+template<typename T>
+bool WorkStealingDeque<T>::pop( T& item )
+{
+    int64 b = _bottom.load( std::memory_order_relaxed ) - 1;
+    Ring* ring = _ring.load( std::memory_order_relaxed );
+    _bottom.store( b, std::memory_order_relaxed );
+    std::atomic_thread_fence( std::memory_order_seq_cst );
+    int64 t = _top.load( std::memory_order_relaxed );
+
+    if ( t > b ) {
+        // Empty
+        _bottom.store( b + 1, std::memory_order_relaxed );
+        return false;
+    }
+
+    item = ring->load( b );
+    if ( t < b )
+        return true;
+
+    // Last element, race the thieves for it
+    bool won = _top.compare_exchange_strong( t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed );
+    _bottom.store( b + 1, std::memory_order_relaxed );
+    return won;
+}
+
+template<typename T>
+bool WorkStealingDeque<T>::steal( T& item )
+{
+    int64 t = _top.load( std::memory_order_acquire );
+    std::atomic_thread_fence( std::memory_order_seq_cst );
+    int64 b = _bottom.load( std::memory_order_acquire );
+
+    Guard( t < b ) return false;
+
+    Ring* ring = _ring.load( std::memory_order_acquire );
+    T candidate = ring->load( t );
+
+    Guard( _top.compare_exchange_strong( t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) ) return false;
+
+    item = candidate;
+    return true;
+}
+
+template<typename T>
+size_t WorkStealingDeque<T>::size_hint() const
+{
+    int64 b = _bottom.load( std::memory_order_relaxed );
+    int64 t = _top.load( std::memory_order_relaxed );
+    return b > t ? (size_t)(b - t) : 0;
+}
+
+ENGINE_NAMESPACE_END
@@ -0,0 +1,114 @@
+#include "stdafx.h"
+#include "worldtransforms.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                     Public Static                      */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+const WorldTransforms::Pose WorldTransforms::IDENTITY_POSE = { Vector3f( 0, 0, 0 ), Vector3f( 1, 1, 1 ), Vector2f( 1, 0 ) };
+
+void WorldTransforms::compute( const RenderSnapshot::Transform* transforms, size_t count, float alpha, Pose* poses, Affine2D* worlds )
+{
+    __m128 a = _mm_set1_ps( alpha );
+
+    for ( size_t i = 0; i < count; ++i ) {
+        const RenderSnapshot::Transform& t = transforms[i];
+
+        // 1# Lerp position and scale
+        __m128 p0 = simd::load3( &t.lastPosition.x );
+        __m128 s0 = simd::load3( &t.lastScale.x );
+        __m128 p  = _mm_add_ps( p0, _mm_mul_ps( _mm_sub_ps( simd::load3( &t.position.x ), p0 ), a ) );
+        __m128 s  = _mm_add_ps( s0, _mm_mul_ps( _mm_sub_ps( simd::load3( &t.scale.x ), s0 ), a ) );
+
+        // 2# Nlerp rotation along the shorter arc. Within one tick the angles are small,
+        //    so this is as good as a slerp without its acos and sin.
+        __m128 q0 = _mm_load_ps( &t.lastRotation.x );
+        __m128 q1 = _mm_load_ps( &t.rotation.x );
+
+        __m128 flip = _mm_and_ps( _mm_cmplt_ps( simd::dot4( q0, q1 ), _mm_setzero_ps() ), _mm_set1_ps( -0.0f ) );
+        q1 = simd::negate( q1, flip );
+
+        __m128 q  = _mm_add_ps( q0, _mm_mul_ps( _mm_sub_ps( q1, q0 ), a ) );
+        __m128 qq = simd::dot4( q, q );
+        q = _mm_cvtss_f32( qq ) > 0.0f ? _mm_div_ps( q, _mm_sqrt_ps( qq ) ) : _mm_setr_ps( 0, 0, 0, 1 );
+
+        // 3# Rotation around z as ( cos, sin ), the doubled angle of ( w, z ). Same as
+        //    Quaternion4f::to_z_angle() but without the atan2 and the cos and sin after it.
+        alignas(16) float r[4];
+        _mm_store_ps( r, q );
+
+        float zw     = r[3] * r[3] + r[2] * r[2];
+        float cosine = zw > 0.0f ? (r[3] * r[3] - r[2] * r[2]) / zw : 1.0f;
+        float sine   = zw > 0.0f ? (2.0f * r[3] * r[2]) / zw : 0.0f;
+
+        Pose& pose = poses[i];
+        simd::store3( &pose.position.x, p );
+        simd::store3( &pose.scale.x, s );
+        pose.rotation = Vector2f( cosine, sine );
+
+        // 4# World = translation * rotation * scale, most entities don't turn
+        worlds[i] = sine == 0.0f && cosine > 0.0f
+                  ? Affine2D::trs<false>( pose.position.x, pose.position.y, cosine, sine, pose.scale.x, pose.scale.y )
+                  : Affine2D::trs<true>( pose.position.x, pose.position.y, cosine, sine, pose.scale.x, pose.scale.y );
+    }
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Public                         */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+WorldTransforms::WorldTransforms() : _snapshot( nullptr )
+{
+}
+
+void WorldTransforms::update( const RenderSnapshot& snapshot, float alpha, JobSystem* jobs )
+{
+    _snapshot = &snapshot;
+
+    const std::vector<RenderSnapshot::Transform>& transforms = snapshot.transforms();
+    size_t count = transforms.size();
+
+    _poses.resize( count );
+    _worlds.resize( count );
+
+    auto kernel = [&]( size_t begin, size_t end ) {
+        compute( transforms.data() + begin, end - begin, alpha, _poses.data() + begin, _worlds.data() + begin );
+    };
+
+    // A single chunk isn't worth the round trip through the workers
+    if ( jobs != nullptr && count > GRAIN_SIZE )
+        jobs->parallel_for( 0, count, GRAIN_SIZE, kernel );
+    else
+        kernel( 0, count );
+}
+
+uint32 WorldTransforms::index_of( Entity entity ) const
+{
+    Guard( _snapshot != nullptr ) return NO_INDEX;
+    return _snapshot->transform_index( entity );
+}
+
+const WorldTransforms::Pose& WorldTransforms::pose( uint32 index ) const
+{
+    Guard( index != NO_INDEX ) return IDENTITY_POSE;
+    Requires( index < _poses.size() );
+
+    return _poses[index];
+}
+
+const Affine2D& WorldTransforms::world( uint32 index ) const
+{
+    Guard( index != NO_INDEX ) return Affine2D::IDENTITY;
+    Requires( index < _worlds.size() );
+
+    return _worlds[index];
+}
+
+size_t WorldTransforms::size() const
+{
+    return _worlds.size();
+}
+
+ENGINE_NAMESPACE_END
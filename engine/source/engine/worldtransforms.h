@@ -0,0 +1,77 @@
+#pragma once
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                        Includes                        */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+// Std-Includes
+#include <vector>
+
+// Other Includes
+
+// Internal Includes
+#include "_global.h"
+#include "noncopyable.h"
+#include "simd.h"
+#include "affine2d.h"
+#include "quaternion4f.h"
+#include "rendersnapshot.h"
+#include "jobsystem.h"
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+/*                         Class                          */
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+ENGINE_NAMESPACE_BEGIN
+
+// Interpolated transforms of all entities for the frame being rendered.
+//
+// update() runs once per frame before any renderer. It interpolates every
+// transform of the snapshot between its last two ticks and builds the
+// 2D world transform, on the workers in chunks of GRAIN_SIZE. Results are
+// contiguous and in the snapshot's transform order, renderers look up
+// their entity once and read from there.
+//
+//    uint32 index = transforms.index_of( entity );
+//    const WorldTransforms::Pose& pose = transforms.pose( index );
+//    const Affine2D& world = transforms.world( index );
+class WorldTransforms : public noncopyable
+{
+public:
+    static const uint32 NO_INDEX   = RenderSnapshot::NO_INDEX;
+    static const size_t GRAIN_SIZE = 256;
+
+    // Interpolated components, rotation is around z as ( cos, sin ), see Affine2D
+    struct Pose {
+        Vector3f    position;
+        Vector3f    scale;
+        Vector2f    rotation;
+    };
+
+    // What entities without a transform get
+    static const Pose       IDENTITY_POSE;
+
+    // The kernel, count transforms at alpha between their last and current tick
+    static void             compute( const RenderSnapshot::Transform* transforms, size_t count, float alpha, Pose* poses, Affine2D* worlds );
+
+                            WorldTransforms();
+                            ~WorldTransforms() = default;
+
+    void                    update( const RenderSnapshot& snapshot, float alpha, JobSystem* jobs );
+
+    // NO_INDEX if the entity has no transform
+    uint32                  index_of( Entity entity ) const;
+
+    // Identity for NO_INDEX
+    const Pose&             pose( uint32 index ) const;
+    const Affine2D&         world( uint32 index ) const;
+
+    size_t                  size() const;
+
+private:
+    const RenderSnapshot*   _snapshot;
+
+    std::vector<Pose>       _poses;
+    std::vector<Affine2D>   _worlds;
+};
+
+ENGINE_NAMESPACE_END
@@ -0,0 +1,120 @@
+#include "catch.h"
+
+#include "_global.h"
+#include "changelog.h"
+#include "transform.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+COMPONENT( CChangeLogTest, 0 )
+  void update( float delta ) override { }
+END
+
+SCENARIO("a changelog reports the changes since a given tick", "[changelog]") {
+    GIVEN("a changelog that a consumer has seen up to now") {
+        ChangeLog<int32> log;
+        tick_t seen = Component::current_tick();
+
+        WHEN("changes are pushed over two ticks") {
+            Component::advance_tick();
+            log.push(1);
+            tick_t middle = Component::current_tick();
+            Component::advance_tick();
+            log.push(2);
+            log.push(3);
+
+            THEN("each_since only returns the newer ones") {
+                std::vector<int32> all, newer;
+                log.each_since(seen,   [&](int32 e) { all.push_back(e); });
+                log.each_since(middle, [&](int32 e) { newer.push_back(e); });
+
+                REQUIRE(all == std::vector<int32>({ 1, 2, 3 }));
+                REQUIRE(newer == std::vector<int32>({ 2, 3 }));
+            }
+        }
+
+        WHEN("the log is cleared") {
+            Component::advance_tick();
+            log.clear();
+
+            THEN("it no longer covers the consumer") {
+                REQUIRE(!log.covers(seen));
+                REQUIRE(log.covers(Component::current_tick()));
+            }
+        }
+
+        WHEN("the consumer falls behind the history") {
+            for (tick_t i = 0; i <= ChangeLog<int32>::HISTORY_TICKS + 1; ++i) {
+                Component::advance_tick();
+                log.push((int32)i);
+            }
+
+            THEN("it no longer covers the consumer") {
+                REQUIRE(!log.covers(seen));
+            }
+        }
+    }
+}
+
+SCENARIO("a component pool reports which entities changed since a given tick", "[changelog]") {
+    GIVEN("two entities with a component, seen by a consumer") {
+        Entity a = Entity::New();
+        Entity b = Entity::New();
+        a.add<CChangeLogTest>();
+        b.add<CChangeLogTest>();
+
+        tick_t seen = Component::current_tick();
+        Component::advance_tick();
+
+        WHEN("one of them is marked changed twice in a tick") {
+            a.get<CChangeLogTest>().mark_changed();
+            a.get<CChangeLogTest>().mark_changed();
+
+            THEN("the pool reports it once") {
+                std::vector<entity_id> changed;
+                CChangeLogTest::get_changes().each_since( seen, [&]( entity_id id ) { changed.push_back( id ); } );
+
+                REQUIRE(changed == std::vector<entity_id>({ a.id() }));
+                REQUIRE(CChangeLogTest::get_changes().changed_tick() == Component::current_tick());
+            }
+        }
+
+        WHEN("nothing is marked changed") {
+            THEN("the pool reports nothing") {
+                size_t changed = 0;
+                CChangeLogTest::get_changes().each_since( seen, [&]( entity_id ) { ++changed; } );
+
+                REQUIRE(changed == 0);
+            }
+        }
+
+        a.destroy();
+        b.destroy();
+        Entity::flush_destroyed();
+    }
+
+    GIVEN("an entity with a transform") {
+        Entity entity = Entity::New();
+        entity.add<CTransform>();
+
+        tick_t seen = Component::current_tick();
+        Component::advance_tick();
+
+        WHEN("its position is written") {
+            entity.get<CTransform>().position().x = 1;
+
+            THEN("the transform pool reports it") {
+                std::vector<entity_id> changed;
+                CTransform::get_changes().each_since( seen, [&]( entity_id id ) { changed.push_back( id ); } );
+
+                REQUIRE(changed == std::vector<entity_id>({ entity.id() }));
+                REQUIRE(entity.get<CTransform>().changed_since( seen ));
+            }
+        }
+
+        entity.destroy();
+        Entity::flush_destroyed();
+    }
+}
+
+ENGINE_NAMESPACE_END
@@ -0,0 +1,135 @@
+#include "catch.h"
+
+#include <thread>
+
+#include "_global.h"
+#include "component.h"
+#include "commandbuffer.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+COMPONENT( CCommandTestA, 0 )
+  void update( float delta ) override { }
+  int32 value = 0;
+END
+
+COMPONENT( CCommandTestB, 0 )
+  void update( float delta ) override { }
+  bool hadA = false;
+END
+
+SCENARIO("structural changes are deferred until playback", "[commandbuffer]") {
+    GIVEN("a thread's command buffer") {
+        CommandBuffer& cmd = CommandBuffer::local();
+
+        WHEN("an entity is spawned and a component is added") {
+            Entity entity = cmd.spawn();
+            cmd.add<CCommandTestA>( entity, []( CCommandTestA& a ) { a.value = 42; } );
+
+            THEN("the entity exists right away, the component only after playback") {
+                REQUIRE(entity.alive());
+                REQUIRE(!entity.has<CCommandTestA>());
+                REQUIRE(cmd.size() == 1);
+
+                CommandBuffer::playback_all();
+
+                REQUIRE(cmd.size() == 0);
+                REQUIRE(entity.has<CCommandTestA>());
+                REQUIRE(entity.get<CCommandTestA>().value == 42);
+            }
+
+            CommandBuffer::playback_all();
+            entity.destroy();
+            Entity::flush_destroyed();
+        }
+
+        WHEN("a component is removed and the entity destroyed") {
+            Entity entity = Entity::New();
+            entity.add<CCommandTestA>();
+
+            cmd.remove<CCommandTestA>( entity );
+            cmd.destroy( entity );
+
+            THEN("the component stays until playback, the entity until the destroy flush") {
+                REQUIRE(entity.has<CCommandTestA>());
+
+                CommandBuffer::playback_all();
+                REQUIRE(!entity.has<CCommandTestA>());
+                REQUIRE(entity.alive());
+
+                Entity::flush_destroyed();
+                REQUIRE(!entity.alive());
+            }
+
+            CommandBuffer::playback_all();
+            Entity::flush_destroyed();
+        }
+
+        WHEN("a component is added to an entity that dies before playback") {
+            Entity entity = Entity::New();
+            cmd.add<CCommandTestA>( entity );
+            entity.destroy();
+            Entity::flush_destroyed();
+
+            THEN("the command is dropped") {
+                size_t pool = CCommandTestA::get_all_components().size();
+                CommandBuffer::playback_all();
+
+                REQUIRE(cmd.size() == 0);
+                REQUIRE(CCommandTestA::get_all_components().size() == pool);
+                REQUIRE(!entity.has<CCommandTestA>());
+            }
+
+            CommandBuffer::playback_all();
+        }
+    }
+}
+
+SCENARIO("playback keeps the recording order of an entity's commands", "[commandbuffer]") {
+    GIVEN("an entity with a component") {
+        CommandBuffer& cmd = CommandBuffer::local();
+        Entity entity = Entity::New();
+        entity.add<CCommandTestA>();
+
+        WHEN("one pool is removed before another is added") {
+            cmd.remove<CCommandTestA>( entity );
+            cmd.add<CCommandTestB>( entity, [entity]( CCommandTestB& b ) mutable { b.hadA = entity.has<CCommandTestA>(); } );
+            CommandBuffer::playback_all();
+
+            THEN("the add sees the removal") {
+                REQUIRE(!entity.has<CCommandTestA>());
+                REQUIRE(entity.has<CCommandTestB>());
+                REQUIRE(!entity.get<CCommandTestB>().hadA);
+            }
+        }
+
+        WHEN("the same pool is removed and added again") {
+            cmd.remove<CCommandTestA>( entity );
+            cmd.add<CCommandTestA>( entity, []( CCommandTestA& a ) { a.value = 7; } );
+            CommandBuffer::playback_all();
+
+            THEN("the component is there with the new value") {
+                REQUIRE(entity.has<CCommandTestA>());
+                REQUIRE(entity.get<CCommandTestA>().value == 7);
+            }
+        }
+
+        WHEN("another thread records for the entity afterwards") {
+            cmd.remove<CCommandTestA>( entity );
+            std::thread( [entity]() {
+                CommandBuffer::local().add<CCommandTestA>( entity, []( CCommandTestA& a ) { a.value = 9; } );
+            } ).join();
+            CommandBuffer::playback_all();
+
+            THEN("its command runs after this thread's, even though its buffer is gone") {
+                REQUIRE(entity.has<CCommandTestA>());
+                REQUIRE(entity.get<CCommandTestA>().value == 9);
+            }
+        }
+
+        entity.destroy();
+        Entity::flush_destroyed();
+    }
+}
+
+ENGINE_NAMESPACE_END
@@ -0,0 +1,102 @@
+#include "catch.h"
+
+#include "_global.h"
+#include "compact_map.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+SCENARIO("values can be put, accessed and checked by key", "[compact_map]") {
+    GIVEN("an empty compact_map") {
+        compact_map<uint64, int32> map;
+
+        REQUIRE(map.size() == 0);
+        REQUIRE(!map.contains(1));
+
+        WHEN("values are put with sparse keys") {
+            map.put(1, 10);
+            map.put(5000, 50);
+            map.put(70000, 700);
+
+            THEN("they can be accessed by their key") {
+                REQUIRE(map.size() == 3);
+                REQUIRE(map.contains(1));
+                REQUIRE(map.contains(5000));
+                REQUIRE(map.contains(70000));
+                REQUIRE(!map.contains(2));
+
+                REQUIRE(map.access(1) == 10);
+                REQUIRE(map.access(5000) == 50);
+                REQUIRE(map.access(70000) == 700);
+            }
+        }
+
+        WHEN("the same key is put twice") {
+            map.put(3, 30);
+            map.put(3, 31);
+
+            THEN("the value is replaced, not duplicated") {
+                REQUIRE(map.size() == 1);
+                REQUIRE(map.access(3) == 31);
+            }
+        }
+
+        WHEN("a key with another generation of a held index is put") {
+            uint64 live  = (uint64(2) << 32) | 3;
+            uint64 stale = (uint64(1) << 32) | 3;
+            map.put(live, 30);
+
+            THEN("it is refused and the held key keeps its value") {
+                REQUIRE_THROWS(map.put(stale, 31));
+                REQUIRE(map.size() == 1);
+                REQUIRE(map.access(live) == 30);
+                REQUIRE(map.keys()[0] == live);
+                REQUIRE(!map.contains(stale));
+            }
+        }
+    }
+}
+
+SCENARIO("removing a value keeps the remaining values contiguous", "[compact_map]") {
+    GIVEN("a compact_map with several values") {
+        compact_map<uint64, int32> map;
+        map.put(1, 10);
+        map.put(2, 20);
+        map.put(3, 30);
+
+        WHEN("a value in the middle is removed") {
+            map.remove(2);
+
+            THEN("the last value takes its place and all are still accessible by their key") {
+                REQUIRE(map.size() == 2);
+                REQUIRE((map.values() == std::vector<int32>{ 10, 30 }));
+                REQUIRE((map.keys() == std::vector<uint64>{ 1, 3 }));
+                REQUIRE(!map.contains(2));
+                REQUIRE(map.access(1) == 10);
+                REQUIRE(map.access(3) == 30);
+            }
+        }
+
+        WHEN("a key that is not contained is removed") {
+            map.remove(42);
+
+            THEN("nothing changes") {
+                REQUIRE(map.size() == 3);
+            }
+        }
+
+        WHEN("all values are removed and put again") {
+            map.remove(3);
+            map.remove(1);
+            map.remove(2);
+            map.put(2, 21);
+
+            THEN("only the new value is contained") {
+                REQUIRE(map.size() == 1);
+                REQUIRE(map.access(2) == 21);
+                REQUIRE(map.keys()[0] == 2);
+            }
+        }
+    }
+}
+
+ENGINE_NAMESPACE_END
@@ -0,0 +1,203 @@
+#include "catch.h"
+
+#include <algorithm>
+
+#include "_global.h"
+#include "component.h"
+#include "entity.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+COMPONENT( CEntityTestA, 0 )
+  void update( float delta ) override { }
+END
+
+COMPONENT( CEntityTestB, 0 )
+  void update( float delta ) override { }
+END
+
+// Asks the registry from its destructor, the destroy flush must not hold the registry lock then
+static int32 DESTROYED_WHILE_DEAD = 0;
+
+COMPONENT( CEntityTestRegistry, 0 )
+  CEntityTestRegistry() = default;
+  CEntityTestRegistry( CEntityTestRegistry&& ) = default;
+  CEntityTestRegistry& operator=( CEntityTestRegistry&& ) = default;
+  ~CEntityTestRegistry() { if ( entity.index() != 0 && !entity.alive() ) ++DESTROYED_WHILE_DEAD; }
+  void update( float delta ) override { }
+END
+
+SCENARIO("destroyed entities leave every pool and their index is recycled", "[entity]") {
+    GIVEN("an entity with two components") {
+        Entity entity = Entity::New();
+        entity.add<CEntityTestA>();
+        entity.add<CEntityTestB>();
+
+        REQUIRE(entity.alive());
+
+        WHEN("it is destroyed") {
+            entity.destroy();
+
+            THEN("its components stay until the destroy queue is flushed") {
+                REQUIRE(entity.has<CEntityTestA>());
+
+                Entity::flush_destroyed();
+
+                REQUIRE(!entity.alive());
+                REQUIRE(!entity.has<CEntityTestA>());
+                REQUIRE(!entity.has<CEntityTestB>());
+            }
+        }
+
+        WHEN("it is destroyed and a new entity is created") {
+            entity.destroy();
+            Entity::flush_destroyed();
+
+            Entity next = Entity::New();
+            next.add<CEntityTestA>();
+
+            THEN("the new entity reuses the index with a new generation") {
+                REQUIRE(next.index() == entity.index());
+                REQUIRE(next.generation() == entity.generation() + 1);
+
+                REQUIRE(next.alive());
+                REQUIRE(!entity.alive());
+                REQUIRE(!entity.has<CEntityTestA>());
+                REQUIRE(entity.try_get<CEntityTestA>() == nullptr);
+            }
+
+            next.destroy();
+            Entity::flush_destroyed();
+        }
+
+        WHEN("its index is reused and components are added through the old handle") {
+            entity.destroy();
+            Entity::flush_destroyed();
+
+            Entity next = Entity::New();
+            next.add<CEntityTestA>();
+
+            THEN("the old handle is refused and the new entity keeps its component") {
+                REQUIRE(next.index() == entity.index());
+                REQUIRE_THROWS(entity.add<CEntityTestA>());
+                REQUIRE_THROWS(entity.remove<CEntityTestA>());
+
+                REQUIRE(next.has<CEntityTestA>());
+                REQUIRE(next.get<CEntityTestA>().entity.id() == next.id());
+                REQUIRE(!entity.has<CEntityTestA>());
+            }
+
+            next.destroy();
+            Entity::flush_destroyed();
+
+            THEN("destroying the new entity still removes its component") {
+                REQUIRE(!next.has<CEntityTestA>());
+            }
+        }
+    }
+}
+
+SCENARIO("component destructors can use the registry while entities are flushed", "[entity]") {
+    GIVEN("an entity with a component that checks its entity on destruction") {
+        Entity entity = Entity::New();
+        entity.add<CEntityTestRegistry>();
+        DESTROYED_WHILE_DEAD = 0;
+
+        WHEN("it is destroyed and flushed") {
+            entity.destroy();
+            Entity::flush_destroyed();
+
+            THEN("the component is gone and saw its entity already dead") {
+                REQUIRE(!entity.has<CEntityTestRegistry>());
+                REQUIRE(DESTROYED_WHILE_DEAD == 1);
+            }
+        }
+    }
+}
+
+SCENARIO("entities can be spawned in batches", "[entity]") {
+    GIVEN("an initializer for two components") {
+        size_t poolA = CEntityTestA::get_all_components().size();
+        size_t poolB = CEntityTestB::get_all_components().size();
+
+        WHEN("a batch is spawned") {
+            std::vector<size_t> initialized;
+            std::vector<entity_id> initializedIds;
+
+            std::vector<Entity> entities = Entity::spawn_batch<CEntityTestA, CEntityTestB>( 100,
+                [&]( size_t i, Entity entity, CEntityTestA& a, CEntityTestB& b ) {
+                    initialized.push_back( i );
+                    initializedIds.push_back( entity.id() );
+                    REQUIRE(a.entity.id() == entity.id());
+                    REQUIRE(b.entity.id() == entity.id());
+                } );
+
+            THEN("count entities are alive and distinct") {
+                REQUIRE(entities.size() == 100);
+
+                std::vector<entity_id> ids;
+                for ( Entity e : entities ) {
+                    REQUIRE(e.alive());
+                    REQUIRE(e.index() != 0);
+                    ids.push_back( e.id() );
+                }
+
+                std::sort( ids.begin(), ids.end() );
+                REQUIRE(std::adjacent_find( ids.begin(), ids.end() ) == ids.end());
+            }
+
+            THEN("every entity has both components, attached to it") {
+                REQUIRE(CEntityTestA::get_all_components().size() == poolA + 100);
+                REQUIRE(CEntityTestB::get_all_components().size() == poolB + 100);
+
+                for ( Entity e : entities ) {
+                    REQUIRE(e.has<CEntityTestA>());
+                    REQUIRE(e.has<CEntityTestB>());
+                    REQUIRE(e.get<CEntityTestA>().entity.id() == e.id());
+                    REQUIRE(e.get<CEntityTestB>().entity.id() == e.id());
+                }
+            }
+
+            THEN("the initializer ran once per entity, in order") {
+                REQUIRE(initialized.size() == 100);
+
+                for ( size_t i = 0; i < entities.size(); ++i ) {
+                    REQUIRE(initialized[i] == i);
+                    REQUIRE(initializedIds[i] == entities[i].id());
+                }
+            }
+
+            for ( Entity e : entities )
+                e.destroy();
+            Entity::flush_destroyed();
+        }
+
+        WHEN("many small batches are spawned") {
+            std::vector<Entity> entities;
+            size_t grown = 0;
+
+            for ( int32 wave = 0; wave < 64; ++wave ) {
+                size_t capacity = CEntityTestA::get_all_components().capacity();
+                std::vector<Entity> batch = Entity::spawn_batch<CEntityTestA>( 16, []( size_t, Entity, CEntityTestA& ) { } );
+                entities.insert( entities.end(), batch.begin(), batch.end() );
+
+                size_t now = CEntityTestA::get_all_components().capacity();
+                if ( now != capacity ) {
+                    ++grown;
+                    REQUIRE(now >= 2 * capacity);
+                }
+            }
+
+            THEN("the pool grows geometrically, not once per batch") {
+                REQUIRE(CEntityTestA::get_all_components().size() >= poolA + 64 * 16);
+                REQUIRE(grown <= 11);
+            }
+
+            for ( Entity e : entities )
+                e.destroy();
+            Entity::flush_destroyed();
+        }
+    }
+}
+
+ENGINE_NAMESPACE_END
@@ -0,0 +1,118 @@
+#include "catch.h"
+
+#include <algorithm>
+#include <random>
+#include <thread>
+
+#include "_global.h"
+#include "jobsystem.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+SCENARIO("the job system spreads work over its workers", "[jobsystem]") {
+    GIVEN("a job system with three workers") {
+        JobSystem jobs( 3 );
+
+        WHEN("a parallel_for covers a range") {
+            std::vector<atomic<uint32>> hits( 10000 );
+            for ( auto& hit : hits ) hit = 0;
+
+            jobs.parallel_for( 0, hits.size(), 64, [&]( size_t begin, size_t end ) {
+                for ( size_t i = begin; i < end; ++i )
+                    hits[i]++;
+            } );
+
+            THEN("every index is visited exactly once") {
+                bool once = std::all_of( hits.begin(), hits.end(), []( const atomic<uint32>& hit ) { return hit == 1; } );
+                REQUIRE(once);
+            }
+        }
+
+        WHEN("a parallel_sort sorts more elements than fit into one run") {
+            std::mt19937 random( 42 );
+            std::vector<int32> values( 5000 );
+            for ( auto& value : values ) value = (int32)(random() % 1000);
+
+            std::vector<int32> expected = values;
+            std::sort( expected.begin(), expected.end() );
+
+            jobs.parallel_sort( values.begin(), values.end(), std::less<int32>(), 300 );
+
+            THEN("the result matches std::sort") {
+                REQUIRE(values == expected);
+            }
+        }
+
+        WHEN("a job is submitted after a group of jobs") {
+            JobCounter     first, second;
+            atomic<uint32> finished( 0 );
+            uint32         seen = 0;
+
+            for ( uint32 i = 0; i < 16; ++i )
+                jobs.submit( [&]() { std::this_thread::yield(); finished++; }, &first );
+
+            jobs.submit_after( first, [&]() { seen = finished; }, &second );
+            jobs.wait( second );
+
+            THEN("it only starts once the whole group is done") {
+                REQUIRE(first.is_done());
+                REQUIRE(seen == 16);
+            }
+        }
+
+        WHEN("a job goes into the main queue") {
+            JobCounter counter;
+            std::thread::id ranOn;
+
+            std::thread other( [&]() {
+                jobs.submit_main( [&]() { ranOn = std::this_thread::get_id(); }, &counter );
+            } );
+            other.join();
+
+            THEN("it waits for the thread that drains the main queue") {
+                REQUIRE(!counter.is_done());
+
+                jobs.run_main_jobs();
+                REQUIRE(counter.is_done());
+                REQUIRE(ranOn == std::this_thread::get_id());
+            }
+        }
+    }
+}
+
+SCENARIO("a work-stealing deque hands out every item exactly once", "[jobsystem]") {
+    GIVEN("an owner pushing and popping while thieves steal") {
+        const uint32 COUNT = 100000;
+
+        WorkStealingDeque<uint32> deque( 16 );
+        std::vector<atomic<uint32>> taken( COUNT );
+        for ( auto& t : taken ) t = 0;
+
+        atomic<bool> done( false );
+        auto thief = [&]() {
+            uint32 item;
+            while ( !done || deque.size_hint() > 0 )
+                if ( deque.steal( item ) ) taken[item]++;
+        };
+
+        std::thread thief1( thief ), thief2( thief );
+
+        uint32 item;
+        for ( uint32 i = 0; i < COUNT; ++i ) {
+            deque.push( i );
+            if ( i % 3 == 0 && deque.pop( item ) ) taken[item]++;
+        }
+        while ( deque.pop( item ) ) taken[item]++;
+
+        done = true;
+        thief1.join();
+        thief2.join();
+
+        THEN("nothing is lost or taken twice") {
+            bool once = std::all_of( taken.begin(), taken.end(), []( const atomic<uint32>& t ) { return t == 1; } );
+            REQUIRE(once);
+        }
+    }
+}
+
+ENGINE_NAMESPACE_END
@@ -0,0 +1,72 @@
+#include "catch.h"
+
+#include <algorithm>
+
+#include "_global.h"
+#include "loosegrid.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+static std::vector<uint32> query_sorted( const LooseGrid& grid, const Rect4f& area )
+{
+    std::vector<uint32> ids;
+    grid.query( area, ids );
+    std::sort( ids.begin(), ids.end() );
+    return ids;
+}
+
+SCENARIO("a loose grid finds the items overlapping an area", "[loosegrid]") {
+    GIVEN("a grid with items spread over several cells") {
+        LooseGrid grid( 4.0f );
+
+        grid.update( 0, Rect4f( 0, 0, 1, 1 ) );
+        grid.update( 1, Rect4f( 3.5f, 0, 1, 1 ) );        // center in the next cell, reaches back
+        grid.update( 2, Rect4f( 100, 100, 2, 2 ) );
+        grid.update( 3, Rect4f( -50, -50, 200, 10 ) );    // larger than a cell
+
+        THEN("a query returns exactly the overlapping items") {
+            REQUIRE((query_sorted( grid, Rect4f( 0, 0, 3.6f, 2 ) ) == std::vector<uint32>{ 0, 1 }));
+            REQUIRE((query_sorted( grid, Rect4f( 2, 0, 1, 1 ) ) == std::vector<uint32>{}));
+            REQUIRE((query_sorted( grid, Rect4f( 99, 99, 2, 2 ) ) == std::vector<uint32>{ 2 }));
+            REQUIRE((query_sorted( grid, Rect4f( -45, -45, 1, 1 ) ) == std::vector<uint32>{ 3 }));
+        }
+
+        THEN("an area covering everything finds everything") {
+            REQUIRE((query_sorted( grid, Rect4f( -1000, -1000, 2000, 2000 ) ) == std::vector<uint32>{ 0, 1, 2, 3 }));
+        }
+
+        WHEN("an item moves within its cell") {
+            size_t cells = grid.num_cells();
+            grid.update( 0, Rect4f( 0.5f, 0.5f, 1, 1 ) );
+
+            THEN("only its bounds change") {
+                REQUIRE(grid.num_cells() == cells);
+                REQUIRE((query_sorted( grid, Rect4f( 1.2f, 1.2f, 0.1f, 0.1f ) ) == std::vector<uint32>{ 0 }));
+            }
+        }
+
+        WHEN("an item moves far away") {
+            grid.update( 2, Rect4f( -20, 30, 1, 1 ) );
+
+            THEN("it is found at its new place only") {
+                REQUIRE((query_sorted( grid, Rect4f( 99, 99, 2, 2 ) ) == std::vector<uint32>{}));
+                REQUIRE((query_sorted( grid, Rect4f( -20, 30, 1, 1 ) ) == std::vector<uint32>{ 2 }));
+                REQUIRE(grid.size() == 4);
+            }
+        }
+
+        WHEN("items are removed") {
+            grid.remove( 1 );
+            grid.remove( 3 );
+            grid.remove( 3 );
+
+            THEN("they are no longer found") {
+                REQUIRE(grid.size() == 2);
+                REQUIRE(!grid.contains( 1 ));
+                REQUIRE((query_sorted( grid, Rect4f( -1000, -1000, 2000, 2000 ) ) == std::vector<uint32>{ 0, 2 }));
+            }
+        }
+    }
+}
+
+ENGINE_NAMESPACE_END
@@ -0,0 +1,229 @@
+#include "catch.h"
+
+#include <chrono>
+
+#include "_global.h"
+#include "matrix4f.h"
+#include "quaternion4f.h"
+#include "affine2d.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+// The scalar kernels Matrix4f and Quaternion4f used before SSE, as reference and baseline
+
+static Matrix4f scalar_mul( const Matrix4f& a, const Matrix4f& o )
+{
+    Matrix4f r;
+    r.m00 = a.m00 * o.m00 + a.m10 * o.m01 + a.m20 * o.m02 + a.m30 * o.m03;
+    r.m01 = a.m01 * o.m00 + a.m11 * o.m01 + a.m21 * o.m02 + a.m31 * o.m03;
+    r.m02 = a.m02 * o.m00 + a.m12 * o.m01 + a.m22 * o.m02 + a.m32 * o.m03;
+    r.m03 = a.m03 * o.m00 + a.m13 * o.m01 + a.m23 * o.m02 + a.m33 * o.m03;
+    r.m10 = a.m00 * o.m10 + a.m10 * o.m11 + a.m20 * o.m12 + a.m30 * o.m13;
+    r.m11 = a.m01 * o.m10 + a.m11 * o.m11 + a.m21 * o.m12 + a.m31 * o.m13;
+    r.m12 = a.m02 * o.m10 + a.m12 * o.m11 + a.m22 * o.m12 + a.m32 * o.m13;
+    r.m13 = a.m03 * o.m10 + a.m13 * o.m11 + a.m23 * o.m12 + a.m33 * o.m13;
+    r.m20 = a.m00 * o.m20 + a.m10 * o.m21 + a.m20 * o.m22 + a.m30 * o.m23;
+    r.m21 = a.m01 * o.m20 + a.m11 * o.m21 + a.m21 * o.m22 + a.m31 * o.m23;
+    r.m22 = a.m02 * o.m20 + a.m12 * o.m21 + a.m22 * o.m22 + a.m32 * o.m23;
+    r.m23 = a.m03 * o.m20 + a.m13 * o.m21 + a.m23 * o.m22 + a.m33 * o.m23;
+    r.m30 = a.m00 * o.m30 + a.m10 * o.m31 + a.m20 * o.m32 + a.m30 * o.m33;
+    r.m31 = a.m01 * o.m30 + a.m11 * o.m31 + a.m21 * o.m32 + a.m31 * o.m33;
+    r.m32 = a.m02 * o.m30 + a.m12 * o.m31 + a.m22 * o.m32 + a.m32 * o.m33;
+    r.m33 = a.m03 * o.m30 + a.m13 * o.m31 + a.m23 * o.m32 + a.m33 * o.m33;
+    return r;
+}
+
+static Quaternion4f scalar_mul( const Quaternion4f& a, const Quaternion4f& o )
+{
+    return Quaternion4f(  a.x * o.w + a.y * o.z - a.z * o.y + a.w * o.x,
+                         -a.x * o.z + a.y * o.w + a.z * o.x + a.w * o.y,
+                          a.x * o.y - a.y * o.x + a.z * o.w + a.w * o.z,
+                         -a.x * o.x - a.y * o.y - a.z * o.z + a.w * o.w );
+}
+
+static bool approx( const Matrix4f& a, const Matrix4f& b )
+{
+    for ( uint32 i = 0; i < 16; ++i )
+        if ( std::abs( a.data()[i] - b.data()[i] ) > 1e-4f ) return false;
+
+    return true;
+}
+
+static Matrix4f sample_matrix()
+{
+    return Matrix4f::translation( Vector3f( 3, -2, 5 ) )
+         * Quaternion4f::to_rotation_mat4f( Quaternion4f::rotation_axis( Vector3f( 0, 0.6f, 0.8f ), 0.7f ) )
+         * Matrix4f::scaling( Vector3f( 2, 0.5f, 4 ) );
+}
+
+SCENARIO("sse matrix kernels match the scalar ones", "[math]") {
+    GIVEN("a transform made of translation, rotation and scale") {
+        Matrix4f m = sample_matrix();
+        Matrix4f p = Matrix4f::ortho2D( -4, 6, -3, 5 );
+
+        THEN("products are the same") {
+            REQUIRE(approx( m * p, scalar_mul( m, p ) ));
+            REQUIRE(approx( p * m, scalar_mul( p, m ) ));
+        }
+
+        THEN("the inverse undoes the matrix") {
+            REQUIRE(approx( m * !m, Matrix4f::IDENTITY ));
+            REQUIRE(approx( !m * m, Matrix4f::IDENTITY ));
+        }
+
+        THEN("a singular matrix has no inverse") {
+            REQUIRE(Matrix4f::is_zero( !Matrix4f::ZERO ));
+        }
+
+        THEN("transposing twice gives the matrix back") {
+            REQUIRE(m.transposed().m01 == m.m10);
+            REQUIRE(m.transposed().transposed() == m);
+        }
+
+        THEN("points transform by the rows, like the shaders do") {
+            Vector3f point( 1, 2, 3 );
+            Vector3f out = m.transform( point );
+
+            REQUIRE(out.x == Approx( m.m00 * 1 + m.m01 * 2 + m.m02 * 3 + m.m03 ));
+            REQUIRE(out.y == Approx( m.m10 * 1 + m.m11 * 2 + m.m12 * 3 + m.m13 ));
+            REQUIRE(out.z == Approx( m.m20 * 1 + m.m21 * 2 + m.m22 * 3 + m.m23 ));
+        }
+    }
+}
+
+SCENARIO("sse quaternion kernels match the scalar ones", "[math]") {
+    GIVEN("two rotations") {
+        Quaternion4f a = Quaternion4f::rotation_axis( Vector3f( 1, 0, 0 ), 0.4f );
+        Quaternion4f b = Quaternion4f::rotation_axis( Vector3f( 0, 0.6f, 0.8f ), -1.3f );
+
+        THEN("products are the same") {
+            Quaternion4f simd = a * b;
+            Quaternion4f scalar = scalar_mul( a, b );
+
+            REQUIRE(simd.x == Approx( scalar.x ));
+            REQUIRE(simd.y == Approx( scalar.y ));
+            REQUIRE(simd.z == Approx( scalar.z ));
+            REQUIRE(simd.w == Approx( scalar.w ));
+        }
+
+        THEN("negation flips all four components") {
+            REQUIRE(-a == Quaternion4f( -a.x, -a.y, -a.z, -a.w ));
+            REQUIRE(a != Quaternion4f( a.x, a.y, a.z, -a.w ));
+        }
+
+        THEN("slerp takes the shorter path to a negated target") {
+            Quaternion4f q = Quaternion4f::slerp( a, -a, 0.5f );
+            REQUIRE(std::abs( Quaternion4f::dot_product( q, a ) ) == Approx( 1.0f ));
+        }
+    }
+}
+
+SCENARIO("2d affine transforms match their 4x4 counterparts", "[math]") {
+    GIVEN("a translation, rotation and scale in the xy plane") {
+        Affine2D a = Affine2D::trs( 3, -2, std::cos( 0.7f ), std::sin( 0.7f ), 2, 0.5f );
+
+        // Matrix4f products apply the left side first, like vec4 * uni_world * uni_projview
+        Matrix4f m = Matrix4f::scaling( Vector3f( 2, 0.5f, 1 ) )
+                   * Quaternion4f::to_rotation_mat4f( Quaternion4f::rotation_axis( Vector3f( 0, 0, 1 ), 0.7f ) )
+                   * Matrix4f::translation( Vector3f( 3, -2, 0 ) );
+
+        THEN("points end up in the same place") {
+            Vector2f out = a.transform( Vector2f( 1, 2 ) );
+            Vector3f ref = m.transform( Vector3f( 1, 2, 0 ) );
+
+            REQUIRE(out.x == Approx( ref.x ));
+            REQUIRE(out.y == Approx( ref.y ));
+        }
+
+        THEN("products apply the right side first") {
+            Affine2D local = Affine2D::trs<false>( -1, 4, 1, 0, 3, 3 );
+            Vector2f out = (a * local).transform( Vector2f( 1, 2 ) );
+            Vector2f ref = a.transform( local.transform( Vector2f( 1, 2 ) ) );
+
+            REQUIRE(out.x == Approx( ref.x ));
+            REQUIRE(out.y == Approx( ref.y ));
+        }
+
+        THEN("products compose in the opposite order to Matrix4f") {
+            Affine2D t = Affine2D::translation( Vector2f( 1, 0 ) );
+            Affine2D s = Affine2D::scaling( Vector2f( 2, 2 ) );
+            Matrix4f mt = Matrix4f::translation( Vector3f( 1, 0, 0 ) );
+            Matrix4f ms = Matrix4f::scaling( Vector3f( 2, 2, 1 ) );
+
+            // Scale first, then translate
+            Vector2f out = (t * s).transform( Vector2f( 1, 1 ) );
+            Vector3f ref = (ms * mt).transform( Vector3f( 1, 1, 0 ) );
+
+            REQUIRE(out.x == Approx( 3 ));
+            REQUIRE(out.y == Approx( 2 ));
+            REQUIRE(ref.x == Approx( 3 ));
+            REQUIRE(ref.y == Approx( 2 ));
+
+            // Translate first, then scale
+            REQUIRE((s * t).transform( Vector2f( 1, 1 ) ).x == Approx( 4 ));
+            REQUIRE((mt * ms).transform( Vector3f( 1, 1, 0 ) ).x == Approx( 4 ));
+        }
+
+        THEN("rect bounds contain the transformed corners") {
+            Rect4f bounds = a.transform( Rect4f( -1, -1, 2, 4 ) );
+
+            for ( Vector2f corner : { Vector2f( -1, -1 ), Vector2f( 1, -1 ), Vector2f( -1, 3 ), Vector2f( 1, 3 ) } ) {
+                Vector2f p = a.transform( corner );
+                REQUIRE(p.x >= bounds.min_x() - 1e-4f);
+                REQUIRE(p.x <= bounds.max_x() + 1e-4f);
+                REQUIRE(p.y >= bounds.min_y() - 1e-4f);
+                REQUIRE(p.y <= bounds.max_y() + 1e-4f);
+            }
+        }
+
+        THEN("the unrotated path is the rotated one at angle 0") {
+            REQUIRE(Affine2D::trs<false>( 3, -2, 1, 0, 2, 0.5f ) == Affine2D::trs<true>( 3, -2, 1, 0, 2, 0.5f ));
+            REQUIRE(Affine2D::rotation( 0.0f ) == Affine2D::IDENTITY);
+        }
+    }
+
+    GIVEN("two rotations a quarter turn apart") {
+        Vector2f r0 = Affine2D::direction( 0.2f );
+        Vector2f r1 = Affine2D::direction( 0.2f + (float)_PI / 2 );
+
+        THEN("nlerp halfway is the angle in between") {
+            REQUIRE(Affine2D::angle( Affine2D::nlerp( r0, r1, 0.5f ) ) == Approx( 0.2f + _PI / 4 ));
+            REQUIRE(Affine2D::nlerp( r0, r1, 0.5f ).length() == Approx( 1.0f ));
+        }
+    }
+}
+
+// Hidden, run with [benchmark]. Per-draw work of a renderer: world matrix from
+// translation, rotation and scale, times proj-view.
+SCENARIO("sse matrix kernels against the scalar baseline", "[.][benchmark]") {
+    const uint32 N = 1000000;
+
+    Matrix4f projView = Matrix4f::ortho2D( -4, 6, -3, 5 );
+    Matrix4f t = Matrix4f::translation( Vector3f( 3, -2, 5 ) );
+    Matrix4f s = Matrix4f::scaling( Vector3f( 2, 0.5f, 4 ) );
+    Quaternion4f q = Quaternion4f::rotation_axis( Vector3f( 0, 0, 1 ), 0.7f );
+
+    float sink = 0;
+    auto time = [&]( auto kernel ) {
+        auto start = std::chrono::high_resolution_clock::now();
+        for ( uint32 i = 0; i < N; ++i ) sink += kernel( (float)i ).m00;
+        return std::chrono::duration<double, std::milli>( std::chrono::high_resolution_clock::now() - start ).count();
+    };
+
+    double scalar = time( [&]( float f ) {
+        Matrix4f r = Quaternion4f::to_rotation_mat4f( q );
+        r.m03 = f;
+        return scalar_mul( scalar_mul( scalar_mul( t, r ), s ), projView );
+    } );
+
+    double sse = time( [&]( float f ) {
+        Matrix4f r = Quaternion4f::to_rotation_mat4f( q );
+        r.m03 = f;
+        return t * r * s * projView;
+    } );
+
+    WARN("scalar: " << scalar << " ms, sse: " << sse << " ms for " << N << " world-view-proj builds (" << sink << ")");
+    REQUIRE(sse > 0);
+}
+
+ENGINE_NAMESPACE_END
@@ -0,0 +1,61 @@
+#include "catch.h"
+
+#include "_global.h"
+#include "rangeallocator.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+SCENARIO("a range allocator hands out first fits and merges freed ranges", "[rangeallocator]") {
+    GIVEN("an allocator with three ranges taken") {
+        RangeAllocator ranges( 100 );
+
+        Range r0 = *ranges.allocate( 10 );
+        Range r1 = *ranges.allocate( 20 );
+        Range r2 = *ranges.allocate( 30 );
+
+        REQUIRE(r0 == Range( 0, 10 ));
+        REQUIRE(r1 == Range( 10, 20 ));
+        REQUIRE(r2 == Range( 30, 30 ));
+        REQUIRE(ranges.used() == 60);
+
+        WHEN("more than the free space is requested") {
+            THEN("the allocation fails until the allocator grows") {
+                REQUIRE(!ranges.allocate( 50 ));
+
+                ranges.grow( 200 );
+                REQUIRE(*ranges.allocate( 50 ) == Range( 60, 50 ));
+            }
+        }
+
+        WHEN("a range in the middle is freed") {
+            ranges.free( r1 );
+
+            THEN("it is reused by the next fitting allocation") {
+                REQUIRE(*ranges.allocate( 15 ) == Range( 10, 15 ));
+                REQUIRE(*ranges.allocate( 15 ) == Range( 60, 15 ));
+            }
+        }
+
+        WHEN("neighbouring ranges are freed") {
+            ranges.free( r0 );
+            ranges.free( r2 );
+            ranges.free( r1 );
+
+            THEN("they merge into one hole") {
+                REQUIRE(ranges.empty());
+                REQUIRE(*ranges.allocate( 100 ) == Range( 0, 100 ));
+            }
+        }
+
+        WHEN("a range is moved towards the front") {
+            ranges.free( r0 );
+
+            THEN("only holes ending before the limit are used") {
+                REQUIRE(!ranges.allocate_below( 30, r2.start() ));
+                REQUIRE(*ranges.allocate_below( 10, r2.start() ) == Range( 0, 10 ));
+            }
+        }
+    }
+}
+
+ENGINE_NAMESPACE_END
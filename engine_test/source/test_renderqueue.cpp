@@ -0,0 +1,72 @@
+#include "catch.h"
+
+#include "_global.h"
+#include "renderqueue.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+SCENARIO("sort keys order by layer, then depth, then state", "[renderqueue]") {
+    GIVEN("keys differing in one field each") {
+        THEN("lower layers come first, regardless of depth") {
+            REQUIRE(RenderQueue::sort_key( -1, 100.f, 0, 0 ) < RenderQueue::sort_key( 0, -100.f, 0, 0 ));
+            REQUIRE(RenderQueue::sort_key( 0, 100.f, 0, 0 ) < RenderQueue::sort_key( 1, -100.f, 0, 0 ));
+        }
+
+        THEN("depths keep their float order, including negatives") {
+            REQUIRE(RenderQueue::sort_key( 0, -2.f, 0, 0 ) < RenderQueue::sort_key( 0, -1.f, 0, 0 ));
+            REQUIRE(RenderQueue::sort_key( 0, -1.f, 0, 0 ) < RenderQueue::sort_key( 0, 0.f, 0, 0 ));
+            REQUIRE(RenderQueue::sort_key( 0, 0.5f, 0, 0 ) < RenderQueue::sort_key( 0, 2.f, 0, 0 ));
+        }
+
+        THEN("shader and texture only break ties") {
+            REQUIRE(RenderQueue::sort_key( 0, 1.f, 2, 0 ) < RenderQueue::sort_key( 0, 1.f, 3, 0 ));
+            REQUIRE(RenderQueue::sort_key( 0, 1.f, 9, 9 ) < RenderQueue::sort_key( 0, 2.f, 1, 1 ));
+        }
+    }
+}
+
+SCENARIO("a render queue sorts items by key and reuses unchanged orders", "[renderqueue]") {
+    GIVEN("a queue with items submitted out of order") {
+        RenderQueue queue;
+
+        queue.submit( RenderQueue::sort_key( 1, 0.f, 0, 0 ), 10 );
+        queue.submit( RenderQueue::sort_key( 0, 5.f, 0, 0 ), 11 );
+        queue.submit( RenderQueue::sort_key( 0, 1.f, 0, 0 ), 12 );
+        queue.submit( RenderQueue::sort_key( 0, 1.f, 0, 0 ), 13 );
+
+        std::vector<uint32> order = queue.sort();
+
+        THEN("they come out by key, equal keys in submission order") {
+            REQUIRE((order == std::vector<uint32>{ 12, 13, 11, 10 }));
+            REQUIRE(!queue.reused_order());
+        }
+
+        WHEN("the same items are submitted with keys that keep their order") {
+            queue.clear();
+            queue.submit( RenderQueue::sort_key( 1, 0.f, 0, 0 ), 10 );
+            queue.submit( RenderQueue::sort_key( 0, 6.f, 0, 0 ), 11 );
+            queue.submit( RenderQueue::sort_key( 0, 1.f, 0, 0 ), 12 );
+            queue.submit( RenderQueue::sort_key( 0, 2.f, 0, 0 ), 13 );
+
+            THEN("the previous order is reused") {
+                REQUIRE((queue.sort() == std::vector<uint32>{ 12, 13, 11, 10 }));
+                REQUIRE(queue.reused_order());
+            }
+        }
+
+        WHEN("an item moves past another") {
+            queue.clear();
+            queue.submit( RenderQueue::sort_key( 1, 0.f, 0, 0 ), 10 );
+            queue.submit( RenderQueue::sort_key( 0, 0.f, 0, 0 ), 11 );
+            queue.submit( RenderQueue::sort_key( 0, 1.f, 0, 0 ), 12 );
+            queue.submit( RenderQueue::sort_key( 0, 1.f, 0, 0 ), 13 );
+
+            THEN("the queue sorts again") {
+                REQUIRE((queue.sort() == std::vector<uint32>{ 11, 12, 13, 10 }));
+                REQUIRE(!queue.reused_order());
+            }
+        }
+    }
+}
+
+ENGINE_NAMESPACE_END
@@ -0,0 +1,112 @@
+#include "catch.h"
+
+#include <algorithm>
+
+#include "_global.h"
+#include "rendersnapshot.h"
+#include "tilemaplogic.h"
+#include "transform.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+static std::vector<uint32> edited_indices( const RenderSnapshot::Tilemap& tilemap, tick_t since )
+{
+    std::vector<uint32> indices;
+    tilemap.edits.each_since( since, [&]( const TileEdit& e ) { indices.push_back( e.y * tilemap.width + e.x ); } );
+    return indices;
+}
+
+SCENARIO("a snapshot patches tilemaps with the edits since it last held them", "[rendersnapshot]") {
+    GIVEN("a tilemap captured into a snapshot") {
+        Entity entity = Entity::New();
+        CTilemapLogic& logic = entity.add<CTilemapLogic>();
+        logic.reshape( 4, 3 );
+
+        RenderSnapshot snapshot;
+        Component::advance_tick();
+        snapshot.capture( Component::current_tick(), 0 );
+        tick_t seen = Component::current_tick();
+
+        REQUIRE(snapshot.find_tilemap( entity ) != nullptr);
+        REQUIRE(snapshot.find_tilemap( entity )->tiles == std::vector<uint32>( 12, 0 ));
+
+        WHEN("tiles are edited over the next ticks") {
+            Component::advance_tick();
+            entity.get<CTilemapLogic>().set_tile( 1, 0, 5 );
+            Component::advance_tick();
+            entity.get<CTilemapLogic>().set_tile( 3, 2, 7 );
+            snapshot.capture( Component::current_tick(), 0 );
+
+            THEN("the snapshot holds the new tiles and reports just those edits") {
+                const RenderSnapshot::Tilemap& tilemap = *snapshot.find_tilemap( entity );
+
+                REQUIRE(tilemap.tiles[1] == 5);
+                REQUIRE(tilemap.tiles[11] == 7);
+                REQUIRE(tilemap.tiles == entity.get<CTilemapLogic>().tiles);
+                REQUIRE(tilemap.edits.covers( seen ));
+                REQUIRE((edited_indices( tilemap, seen ) == std::vector<uint32>{ 1, 11 }));
+            }
+        }
+
+        WHEN("the tilemap is reshaped") {
+            Component::advance_tick();
+            entity.get<CTilemapLogic>().reshape( 2, 2 );
+            entity.get<CTilemapLogic>().set_tile( 1, 1, 3 );
+            snapshot.capture( Component::current_tick(), 0 );
+
+            THEN("the snapshot copies it whole and consumers have to resync") {
+                const RenderSnapshot::Tilemap& tilemap = *snapshot.find_tilemap( entity );
+
+                REQUIRE(tilemap.width == 2);
+                REQUIRE(tilemap.height == 2);
+                REQUIRE(tilemap.tiles == std::vector<uint32>({ 0, 0, 0, 3 }));
+                REQUIRE(!tilemap.edits.covers( seen ));
+            }
+        }
+
+        entity.destroy();
+        Entity::flush_destroyed();
+    }
+}
+
+SCENARIO("a snapshot reports the entities whose bounds may have changed", "[rendersnapshot]") {
+    GIVEN("two transforms and a tilemap captured into a snapshot") {
+        Entity moving = Entity::New();
+        Entity still  = Entity::New();
+        Entity map    = Entity::New();
+        moving.add<CTransform>();
+        still.add<CTransform>();
+        map.add<CTilemapLogic>().reshape( 2, 2 );
+
+        RenderSnapshot snapshot;
+        Component::advance_tick();
+        snapshot.capture( Component::current_tick(), 0 );
+        tick_t seen = Component::current_tick();
+
+        WHEN("one entity moves and the tilemap is reshaped over the next ticks") {
+            Component::advance_tick();
+            moving.get<CTransform>().position().x = 5;
+            Component::advance_tick();
+            map.get<CTilemapLogic>().reshape( 3, 3 );
+            snapshot.capture( Component::current_tick(), 0 );
+
+            THEN("just those two are reported since the last capture") {
+                std::vector<entity_id> changed;
+                REQUIRE(snapshot.bounds_changes().covers( seen ));
+                snapshot.bounds_changes().each_since( seen, [&]( entity_id id ) { changed.push_back( id ); } );
+
+                std::sort( changed.begin(), changed.end() );
+                std::vector<entity_id> expected = { moving.id(), map.id() };
+                std::sort( expected.begin(), expected.end() );
+                REQUIRE(changed == expected);
+            }
+        }
+
+        moving.destroy();
+        still.destroy();
+        map.destroy();
+        Entity::flush_destroyed();
+    }
+}
+
+ENGINE_NAMESPACE_END
@@ -0,0 +1,71 @@
+#include "catch.h"
+
+#include "_global.h"
+#include "component.h"
+#include "systemscheduler.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+COMPONENT( CSchedulerTestA, 0 )
+  void update( float delta ) override { }
+
+  int32 value = 0;
+END
+
+COMPONENT( CSchedulerTestB, 0 )
+  void update( float delta ) override { }
+
+  int32 value = 0;
+END
+
+SCENARIO("systems run once per tick in dependency order", "[systemscheduler]") {
+    GIVEN("a scheduler and entities with components") {
+        owner<JobSystem> jobs = make_owner<JobSystem>( 3 );
+        SystemScheduler  scheduler( jobs.get_non_owner() );
+
+        for ( entity_id id = 1; id <= 1000; ++id ) {
+            CSchedulerTestA::get_all_components().put( id, CSchedulerTestA() );
+            if ( id % 2 == 0 )
+                CSchedulerTestB::get_all_components().put( id, CSchedulerTestB() );
+        }
+
+        WHEN("two conflicting systems are added in reverse priority order") {
+            scheduler.add( System( "double", 20 )
+                .writes<CSchedulerTestA>()
+                .each<CSchedulerTestA>( []( float, Entity, CSchedulerTestA& a ) { a.value *= 2; }, 64 ) );
+
+            scheduler.add( System( "increment", 10 )
+                .writes<CSchedulerTestA>()
+                .each<CSchedulerTestA>( []( float, Entity, CSchedulerTestA& a ) { a.value += 1; }, 64 ) );
+
+            scheduler.run( 0.02f );
+
+            THEN("the lower priority runs first for every entity") {
+                for ( auto& a : CSchedulerTestA::get_all_components().values() )
+                    REQUIRE( a.value == 2 );
+            }
+        }
+
+        WHEN("a system joins two pools") {
+            scheduler.add( System( "join", 0 )
+                .reads<CSchedulerTestA>()
+                .writes<CSchedulerTestB>()
+                .each<CSchedulerTestA, CSchedulerTestB>( []( float, Entity, CSchedulerTestA&, CSchedulerTestB& b ) { b.value++; }, 16 ) );
+
+            scheduler.run( 0.02f );
+            scheduler.run( 0.02f );
+
+            THEN("every matching entity is visited exactly once per tick") {
+                for ( auto& b : CSchedulerTestB::get_all_components().values() )
+                    REQUIRE( b.value == 2 );
+            }
+        }
+
+        for ( entity_id id = 1; id <= 1000; ++id ) {
+            CSchedulerTestA::get_all_components().remove( id );
+            CSchedulerTestB::get_all_components().remove( id );
+        }
+    }
+}
+
+ENGINE_NAMESPACE_END
@@ -0,0 +1,59 @@
+#include "catch.h"
+
+#include <thread>
+
+#include "_global.h"
+#include "triplebuffer.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+SCENARIO("a triple buffer hands the latest published object to the reader", "[triplebuffer]") {
+    GIVEN("a triple buffer") {
+        TripleBuffer<int32> buffer;
+
+        WHEN("several objects are published before the reader looks") {
+            for ( int32 i = 1; i <= 5; ++i ) {
+                buffer.write() = i;
+                buffer.publish();
+            }
+
+            THEN("the reader gets the last one and keeps it until the next publish") {
+                REQUIRE(buffer.acquire() == 5);
+                REQUIRE(buffer.acquire() == 5);
+
+                buffer.write() = 6;
+                REQUIRE(buffer.acquire() == 5);
+
+                buffer.publish();
+                REQUIRE(buffer.acquire() == 6);
+            }
+        }
+
+        WHEN("writer and reader run on different threads") {
+            const int32 COUNT = 100000;
+
+            std::thread writer( [&]() {
+                for ( int32 i = 1; i <= COUNT; ++i ) {
+                    buffer.write() = i;
+                    buffer.publish();
+                }
+            } );
+
+            bool  ordered = true;
+            int32 last    = 0;
+            while ( last < COUNT ) {
+                int32 value = buffer.acquire();
+                ordered = ordered && value >= last;
+                last = value;
+            }
+            writer.join();
+
+            THEN("the reader never goes back in time") {
+                REQUIRE(ordered);
+                REQUIRE(last == COUNT);
+            }
+        }
+    }
+}
+
+ENGINE_NAMESPACE_END
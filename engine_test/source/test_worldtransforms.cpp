@@ -0,0 +1,50 @@
+#include "catch.h"
+
+#include "_global.h"
+#include "worldtransforms.h"
+
+ENGINE_NAMESPACE_BEGIN
+
+SCENARIO("world transforms interpolate and compose all transforms in one pass", "[worldtransforms]") {
+    GIVEN("a transform that moves, grows and turns by 90 degrees over a tick") {
+        RenderSnapshot::Transform transform;
+        transform.lastPosition = Vector3f( 0, 0, 0 );
+        transform.position     = Vector3f( 2, 4, -1 );
+        transform.lastScale    = Vector3f( 1, 1, 1 );
+        transform.scale        = Vector3f( 3, 1, 1 );
+        transform.lastRotation = Quaternion4f::rotation_axis( Vector3f( 0, 0, 1 ), 0.0f );
+        transform.rotation     = Quaternion4f::rotation_axis( Vector3f( 0, 0, 1 ), (float)_PI / 2 );
+
+        WorldTransforms::Pose pose;
+        Affine2D world;
+
+        WHEN("computed halfway") {
+            WorldTransforms::compute( &transform, 1, 0.5f, &pose, &world );
+
+            THEN("position and scale are lerped, the angle is halfway") {
+                REQUIRE(pose.position == Vector3f( 1, 2, -0.5f ));
+                REQUIRE(pose.scale == Vector3f( 2, 1, 1 ));
+                REQUIRE(Affine2D::angle( pose.rotation ) == Approx( _PI / 4 ));
+            }
+
+            THEN("the world transform scales, then rotates, then translates") {
+                Vector2f p = world.transform( Vector2f( 1, 0 ) );
+                float d = std::sqrt( 2.0f );
+
+                REQUIRE(p.x == Approx( 1 + d ));
+                REQUIRE(p.y == Approx( 2 + d ));
+            }
+        }
+
+        WHEN("the current rotation is stored negated") {
+            transform.rotation = -transform.rotation;
+            WorldTransforms::compute( &transform, 1, 0.5f, &pose, &world );
+
+            THEN("it still turns the short way") {
+                REQUIRE(Affine2D::angle( pose.rotation ) == Approx( _PI / 4 ));
+            }
+        }
+    }
+}
+
+ENGINE_NAMESPACE_END